@@ -0,0 +1,61 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   Alan Prado
+ *
+ * This file is part of Banana, a one-sided crossing minimization solver.
+ *
+ * Copyright (c) 2024 by the authors listed in the file AUTHORS in the
+ * top-level source directory and their institutional affiliations. All rights
+ * reserved. See the file LICENSE.md in the top-level source directory for
+ * licensing information.
+ * ****************************************************************************
+ *
+ * Adjacent exchange local search.
+ */
+
+#include "adjacent_exchange.h"
+#include "crossing_matrix.h"
+#include "environment.h"
+
+namespace banana {
+namespace solver {
+namespace heuristic {
+namespace exchange {
+
+AdjacentExchange::AdjacentExchange(graph::BipartiteGraph graph)
+    : ImprovementRoutine(graph)
+{}
+
+long long AdjacentExchange::improve(std::vector<int> &order,
+                                     long long crossings)
+{
+  const utils::Deadline &deadline = Environment::deadline();
+  bool improved = true;
+  while (improved && !deadline.expired())
+  {
+    improved = false;
+    for (int i = 0; i + 1 < (int)order.size(); i++)
+    {
+      const auto &nu = m_neighbors[order[i] - m_offset];
+      const auto &nv = m_neighbors[order[i + 1] - m_offset];
+      auto [uv, vu] = crossing::CrossingMatrix::pairCrossings(nu, nv);
+      if (vu < uv)
+      {
+        std::swap(order[i], order[i + 1]);
+        crossings -= uv - vu;
+        improved = true;
+      }
+    }
+    /** Sweeps cost more than a copy, so each one is kept in case of SIGTERM */
+    if (improved)
+      publish(order, crossings);
+  }
+
+  m_order = order;
+  return crossings;
+}
+
+} // namespace exchange
+} // namespace heuristic
+} // namespace solver
+} // namespace banana
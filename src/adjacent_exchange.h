@@ -0,0 +1,50 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   Alan Prado
+ *
+ * This file is part of Banana, a one-sided crossing minimization solver.
+ *
+ * Copyright (c) 2024 by the authors listed in the file AUTHORS in the
+ * top-level source directory and their institutional affiliations. All rights
+ * reserved. See the file LICENSE.md in the top-level source directory for
+ * licensing information.
+ * ****************************************************************************
+ *
+ * Adjacent exchange local search.
+ */
+
+#ifndef __PACE2024__ADJACENT_EXCHANGE_H
+#define __PACE2024__ADJACENT_EXCHANGE_H
+
+#include "improvement_routine.h"
+
+#include <vector>
+
+namespace banana {
+namespace solver {
+namespace heuristic {
+namespace exchange {
+
+/**
+ * Adjacent exchange
+ *
+ * Sweeps the order swapping neighboring vertices u, v whenever c_{v,u} <
+ * c_{u,v}, until a sweep changes nothing or the deadline expires. Crossing
+ * numbers are computed on demand from the sorted neighborhoods, so memory is
+ * linear in the size of the graph.
+ */
+class AdjacentExchange : public ImprovementRoutine
+{
+public:
+  AdjacentExchange(graph::BipartiteGraph graph);
+  ~AdjacentExchange() override = default;
+  using ImprovementRoutine::improve;
+  long long improve(std::vector<int> &order, long long crossings) override;
+};
+
+} // namespace exchange
+} // namespace heuristic
+} // namespace solver
+} // namespace banana
+
+#endif // __PACE2024__ADJACENT_EXCHANGE_H
@@ -0,0 +1,127 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   Alan Prado
+ *
+ * This file is part of Banana, a one-sided crossing minimization solver.
+ *
+ * Copyright (c) 2024 by the authors listed in the file AUTHORS in the
+ * top-level source directory and their institutional affiliations. All rights
+ * reserved. See the file LICENSE.md in the top-level source directory for
+ * licensing information.
+ * ****************************************************************************
+ *
+ * Anytime heuristic pipeline.
+ */
+
+#include "anytime_solver.h"
+#include "adjacent_exchange.h"
+#include "barycenter_heuristic.h"
+#include "beam_search.h"
+#include "block_move.h"
+#include "eades_lin_smyth.h"
+#include "greedy_switch.h"
+#include "insertion_heuristic.h"
+#include "kwik_sort.h"
+#include "large_neighborhood_search.h"
+#include "median_heuristic.h"
+#include "memetic_algorithm.h"
+#include "merge_sort_heuristic.h"
+#include "multi_start_search.h"
+#include "multilevel_heuristic.h"
+#include "sifting.h"
+#include "spectral_ordering.h"
+#include "simulated_annealing.h"
+#include "tabu_search.h"
+#include "window_dp.h"
+
+namespace banana {
+namespace solver {
+
+AnytimeSolver::AnytimeSolver(graph::BipartiteGraph graph)
+    : MetaSolver<graph::BipartiteGraph, int>(graph), m_portfolio(graph)
+{
+  std::shared_ptr<const crossing::DenseCrossingMatrix> matrix;
+  if (crossing::DenseCrossingMatrix::fits(graph))
+    matrix = std::make_shared<crossing::DenseCrossingMatrix>(graph);
+
+  m_portfolio.addConstructive(
+      std::make_unique<heuristic::barycenter::BarycenterHeuristic>(graph));
+  m_portfolio.addConstructive(
+      std::make_unique<heuristic::median::MedianHeuristic>(graph));
+  m_portfolio.addConstructive(
+      std::make_unique<heuristic::mergesort::MergeSortHeuristic>(graph));
+  m_portfolio.addConstructive(
+      std::make_unique<heuristic::kwiksort::KwikSort>(graph));
+  m_portfolio.addConstructive(
+      std::make_unique<heuristic::spectral::SpectralOrdering>(graph));
+  if (heuristic::eadeslinsmyth::EadesLinSmyth::fits(graph))
+  {
+    m_portfolio.addConstructive(
+        std::make_unique<heuristic::eadeslinsmyth::EadesLinSmyth>(graph));
+  }
+  if (matrix != nullptr)
+  {
+    m_portfolio.addConstructive(
+        std::make_unique<heuristic::beam::BeamSearch>(graph, matrix));
+  }
+  else
+  {
+    m_portfolio.addConstructive(
+        std::make_unique<heuristic::multilevel::MultilevelHeuristic>(graph));
+  }
+
+  /**
+   * First tried in this order, cheapest first: exchanges and small exact
+   * windows, then sifting, block moves and tabu search, multi-start,
+   * annealing, the memetic algorithm, and large exact windows
+   */
+  if (matrix != nullptr)
+  {
+    m_portfolio.addImprovement(
+        std::make_unique<heuristic::exchange::GreedySwitch>(graph, matrix));
+    m_portfolio.addImprovement(
+        std::make_unique<heuristic::windowdp::WindowDP>(graph, matrix));
+    m_portfolio.addImprovement(
+        std::make_unique<heuristic::sifting::Sifting>(graph));
+    m_portfolio.addImprovement(
+        std::make_unique<heuristic::blockmove::BlockMove>(graph, matrix));
+    m_portfolio.addImprovement(
+        std::make_unique<heuristic::tabu::TabuSearch>(graph, matrix));
+  }
+  else
+  {
+    m_portfolio.addImprovement(
+        std::make_unique<heuristic::exchange::AdjacentExchange>(graph));
+    m_portfolio.addImprovement(
+        std::make_unique<heuristic::windowdp::WindowDP>(graph));
+    m_portfolio.addImprovement(
+        std::make_unique<heuristic::insertion::InsertionHeuristic>(graph));
+  }
+  m_portfolio.addImprovement(
+      std::make_unique<heuristic::multistart::MultiStartSearch>(graph, matrix));
+  m_portfolio.addImprovement(
+      std::make_unique<heuristic::annealing::SimulatedAnnealing>(graph,
+                                                                 matrix));
+  m_portfolio.addImprovement(
+      std::make_unique<heuristic::memetic::MemeticAlgorithm>(graph, matrix));
+#ifdef USE_LPSOLVE
+  m_portfolio.addImprovement(
+      std::make_unique<heuristic::lns::LargeNeighborhoodSearch>(graph));
+#endif
+}
+
+long long AnytimeSolver::solve()
+{
+  /** The input order is a valid answer before anything else runs */
+  m_order = m_graph.getB();
+  publish(m_order, numberOfCrossings(m_order));
+
+  m_portfolio.setIncumbent(m_incumbent);
+  long long crossings = m_portfolio.solve();
+  m_order.clear();
+  m_portfolio.explain(m_order);
+  return crossings;
+}
+
+} // namespace solver
+} // namespace banana
@@ -0,0 +1,48 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   Alan Prado
+ *
+ * This file is part of Banana, a one-sided crossing minimization solver.
+ *
+ * Copyright (c) 2024 by the authors listed in the file AUTHORS in the
+ * top-level source directory and their institutional affiliations. All rights
+ * reserved. See the file LICENSE.md in the top-level source directory for
+ * licensing information.
+ * ****************************************************************************
+ *
+ * Anytime heuristic pipeline.
+ */
+
+#ifndef __PACE2024__ANYTIME_SOLVER_H
+#define __PACE2024__ANYTIME_SOLVER_H
+
+#include "meta_solver.h"
+#include "portfolio.h"
+
+namespace banana {
+namespace solver {
+
+/**
+ * Anytime solver
+ *
+ * Schedules the constructive heuristics and the improvement routines as a
+ * portfolio (see portfolio.h), which runs until no routine improves the
+ * best order or the deadline expires. Every order found is published to the
+ * incumbent, so a complete order is available to print at any moment.
+ */
+class AnytimeSolver : public MetaSolver<graph::BipartiteGraph, int>
+{
+public:
+  AnytimeSolver(graph::BipartiteGraph graph);
+  ~AnytimeSolver() override = default;
+  /** Returns the best crossings found */
+  long long solve() override;
+
+protected:
+  heuristic::portfolio::Portfolio m_portfolio;
+};
+
+} // namespace solver
+} // namespace banana
+
+#endif // __PACE2024__ANYTIME_SOLVER_H
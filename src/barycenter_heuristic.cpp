@@ -14,6 +14,8 @@
  */
 
 #include "barycenter_heuristic.h"
+#include "tie_resolution.h"
+
 #include <algorithm>
 
 namespace banana {
@@ -38,9 +40,9 @@ BarycenterHeuristic::BarycenterHeuristic(graph::BipartiteGraph graph)
  *
  * To avoid working with non-integer values, the corresponding mean for each
  * node is represented as a fraction by the pair (sum of neighbors, number of
- * neighbors)
+ * neighbors). Ties are ordered by TieResolution.
  */
-int BarycenterHeuristic::solve()
+long long BarycenterHeuristic::solve()
 {
   int n = m_graph.countVerticesB();
   int offset = m_graph.countVerticesA();
@@ -51,20 +53,29 @@ int BarycenterHeuristic::solve()
     b_layer.push_back(i);
   }
 
-  std::sort(b_layer.begin(), b_layer.end(), [&](int node1, int node2) {
-    long long v1 = (1ll * m_neighborhoodInfo[node1].first *
-                    m_neighborhoodInfo[node2].second);
-    long long v2 = (1ll * m_neighborhoodInfo[node2].first *
-                    m_neighborhoodInfo[node1].second);
-    return (v1 < v2);
-  });
+  /** Isolated vertices never cross, so they count as barycenter 0 */
+  auto less = [&](int node1, int node2) {
+    auto [sum1, size1] = m_neighborhoodInfo[node1];
+    auto [sum2, size2] = m_neighborhoodInfo[node2];
+    return 1ll * sum1 * std::max(size2, 1) < 1ll * sum2 * std::max(size1, 1);
+  };
+  std::stable_sort(b_layer.begin(), b_layer.end(), less);
+
+  /** Vertices with equal barycenters get the same key */
+  std::vector<long long> key(n);
+  for (int i = 1; i < n; ++i)
+  {
+    key[i] = key[i - 1] + less(b_layer[i - 1], b_layer[i]);
+  }
 
   for (int i = 0; i < n; ++i)
   {
     b_layer[i] += offset;
   }
+  ties::TieResolution(m_graph).resolve(b_layer, key);
 
-  return numberOfCrossings(b_layer);
+  m_order = b_layer;
+  return numberOfCrossings(m_order);
 }
 
 /**
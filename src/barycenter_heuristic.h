@@ -51,7 +51,7 @@ class BarycenterHeuristic : public ApproximationRoutine
 public:
   BarycenterHeuristic(graph::BipartiteGraph graph);
   ~BarycenterHeuristic() override = default;
-  int solve() override;
+  long long solve() override;
 
 private:
   std::vector<std::pair<int, int>> m_neighborhoodInfo;
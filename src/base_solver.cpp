@@ -14,6 +14,9 @@
  */
 
 #include "base_solver.h"
+#include "anytime_solver.h"
+#include "barycenter_heuristic.h"
+#include "deadline.h"
 #include "environment.h"
 #include "ip_solver_or.h"
 #include "ip_solver_gurobi.h"
@@ -21,12 +24,40 @@
 #include "options.h"
 #include "utils.h"
 
+#include <csignal>
 #include <memory>
+#include <unistd.h>
 
 namespace banana {
 namespace solver {
 
-BaseSolver::BaseSolver(graph::BipartiteGraph graph) : m_graph(graph)
+/** Incumbent printed on SIGTERM */
+static Incumbent *TerminationIncumbent = nullptr;
+
+/**
+ * Prints the best order known and exits. If the order is already being
+ * printed, returns and lets the printing finish.
+ */
+static void on_termination(int)
+{
+  if (TerminationIncumbent->empty())
+    _exit(1);
+  if (TerminationIncumbent->writeOrder(STDOUT_FILENO))
+    _exit(0);
+}
+
+static void install_termination_handler(Incumbent *incumbent)
+{
+  TerminationIncumbent = incumbent;
+  struct sigaction action = {};
+  action.sa_handler = on_termination;
+  sigemptyset(&action.sa_mask);
+  action.sa_flags = SA_RESTART;
+  sigaction(SIGTERM, &action, nullptr);
+}
+
+BaseSolver::BaseSolver(graph::BipartiteGraph graph)
+    : m_graph(graph), m_incumbent(graph.countVerticesB())
 {
   const auto &ip_solver = Environment::options().ip.solverMode;
   const auto &ip_sub_solver = Environment::options().ip.subSolverMode;
@@ -51,34 +82,88 @@ BaseSolver::BaseSolver(graph::BipartiteGraph graph) : m_graph(graph)
     throw std::invalid_argument("Invalid IP Solver!");
 
   }
+  m_ipSolver->setIncumbent(&m_incumbent);
 }
 
-void BaseSolver::verifySolution(int expected_crossings)
+void BaseSolver::verifySolution(long long expected_crossings)
 {
   std::string path = Environment::options().verify.verifyPath;
   std::vector<int> order = utils::readSolution<int>(path);
   assert(m_ipSolver->verify(order, expected_crossings));
 }
 
+long long BaseSolver::fallbackOrder(std::vector<int> &order)
+{
+  if (m_incumbent.empty())
+  {
+    heuristic::barycenter::BarycenterHeuristic barycenter(m_graph);
+    long long crossings = barycenter.solve();
+    std::vector<int> barycenter_order;
+    barycenter.explain(barycenter_order);
+    m_incumbent.offer(barycenter_order, crossings);
+  }
+  order = m_incumbent.order();
+  return m_incumbent.crossings();
+}
+
+void BaseSolver::runAnytime()
+{
+  AnytimeSolver anytime(m_graph);
+  anytime.setIncumbent(&m_incumbent);
+  anytime.solve();
+}
+
 void BaseSolver::runBanana()
 {
-  int crossings = m_ipSolver->solve();
+  install_termination_handler(&m_incumbent);
+  if (Environment::options().general.anytime)
+  {
+    runAnytime();
+    printOrder();
+    return;
+  }
+
+  long long crossings = -1;
   std::vector<int> order;
-  m_ipSolver->explain(order);
+  try
+  {
+    crossings = m_ipSolver->solve();
+    m_ipSolver->explain(order);
+  }
+  catch (const utils::TimeLimitExceeded &)
+  {
+    std::cerr << "time limit exceeded" << std::endl;
+  }
+
+  /** Without a proof of optimality, print the best order known */
+  bool optimal = crossings != -1 && m_ipSolver->provenOptimal();
+  if (!optimal)
+  {
+    if (crossings != -1)
+      m_incumbent.offer(order, crossings);
+    order.clear();
+    crossings = fallbackOrder(order);
+  }
+
   for (int vertex : order)
   {
     std::cerr << vertex + 1 << "\n";
   }
   assert(m_ipSolver->verify(order, crossings));
-  if (Environment::options().verify.verifyMode ==
-      banana::options::VerifyMode::COMPLETE)
+  if (optimal && Environment::options().verify.verifyMode ==
+                     banana::options::VerifyMode::COMPLETE)
   {
     verifySolution(crossings);
   }
-  for (int vertex : order)
-  {
-    std::cout << vertex + 1 << "\n";
-  }
+  /** An order as good as the optimal one may already be there */
+  m_incumbent.offer(order, crossings);
+  printOrder();
+}
+
+void BaseSolver::printOrder()
+{
+  std::cout.flush();
+  m_incumbent.writeOrder(STDOUT_FILENO);
 }
 
 } // namespace solver
@@ -17,6 +17,7 @@
 #define __PACE2024__BASE_SOLVER_HPP
 
 #include "bipartite_graph.h"
+#include "incumbent.h"
 #include "ip_solver.h"
 
 #include <memory>
@@ -38,7 +39,15 @@ protected:
   /** Integer programming solver. */
   std::unique_ptr<ip::IntegerProgrammingSolverBase> m_ipSolver;
   const graph::BipartiteGraph m_graph;
-  void verifySolution(int expectedCrossings);
+  /** Best order found by any solver, printed if the time limit expires */
+  Incumbent m_incumbent;
+  void verifySolution(long long expectedCrossings);
+  /** Best order known, computing one with a heuristic if needed */
+  long long fallbackOrder(std::vector<int> &order);
+  /** Heuristics only, until they stop improving or the time limit */
+  void runAnytime();
+  /** Prints the incumbent, unless the SIGTERM handler already did */
+  void printOrder();
 };
 
 } // namespace solver
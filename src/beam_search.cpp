@@ -0,0 +1,194 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   Alan Prado
+ *
+ * This file is part of Banana, a one-sided crossing minimization solver.
+ *
+ * Copyright (c) 2024 by the authors listed in the file AUTHORS in the
+ * top-level source directory and their institutional affiliations. All rights
+ * reserved. See the file LICENSE.md in the top-level source directory for
+ * licensing information.
+ * ****************************************************************************
+ *
+ * Beam search over prefixes of orders.
+ */
+
+#include "beam_search.h"
+#include "barycenter_heuristic.h"
+#include "environment.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <random>
+#include <unordered_set>
+
+namespace banana {
+namespace solver {
+namespace heuristic {
+namespace beam {
+
+BeamSearch::BeamSearch(
+    graph::BipartiteGraph graph,
+    std::shared_ptr<const crossing::DenseCrossingMatrix> matrix)
+    : ApproximationRoutine(graph), m_offset(graph.countVerticesA()),
+      m_matrix(matrix), m_width(Environment::options().heuristic.beamWidth)
+{
+  if (m_matrix == nullptr && crossing::DenseCrossingMatrix::fits(graph))
+    m_matrix = std::make_shared<crossing::DenseCrossingMatrix>(graph);
+}
+
+void BeamSearch::setWidth(int width) { m_width = std::max(width, 1); }
+
+BeamSearch::Extension BeamSearch::extend(const Prefix &prefix, int parent,
+                                         int v) const
+{
+  long long crossings = prefix.crossings + prefix.cost[v];
+  long long pending =
+      prefix.pending - prefix.cost[v] + m_total[v] - prefix.reverse[v];
+  long long bound = prefix.bound - (m_minimum[v] - prefix.spent[v]);
+  long long score = crossings + pending + bound;
+  return {score, m_rank[v], parent, v};
+}
+
+void BeamSearch::apply(Prefix &prefix, const Extension &extension) const
+{
+  const crossing::DenseCrossingMatrix &matrix = *m_matrix;
+  int v = extension.v;
+  prefix.crossings += prefix.cost[v];
+  prefix.pending += m_total[v] - prefix.reverse[v] - prefix.cost[v];
+  prefix.bound -= m_minimum[v] - prefix.spent[v];
+  prefix.placed[v] = true;
+  prefix.order.push_back(v + m_offset);
+  prefix.hash ^= m_zobrist[v];
+
+  const int *row = matrix.row(v);
+  for (int u = 0; u < matrix.size(); u++)
+  {
+    if (prefix.placed[u])
+      continue;
+    int reverse = matrix(u, v);
+    prefix.cost[u] += row[u];
+    prefix.reverse[u] += reverse;
+    prefix.spent[u] += std::min(row[u], reverse);
+  }
+}
+
+long long BeamSearch::solve()
+{
+  barycenter::BarycenterHeuristic barycenter(m_graph);
+  barycenter.solve();
+  std::vector<int> start;
+  barycenter.explain(start);
+  if (m_matrix == nullptr)
+  {
+    m_order = start;
+    return numberOfCrossings(m_order);
+  }
+
+  const crossing::DenseCrossingMatrix &matrix = *m_matrix;
+  int n = matrix.size();
+  m_rank.resize(n);
+  for (int i = 0; i < n; i++)
+  {
+    m_rank[start[i] - m_offset] = i;
+  }
+  m_minimum.assign(n, 0), m_total.assign(n, 0);
+  library::ThreadPool::global().parallelFor(
+      0, n,
+      [&](int v) {
+        const int *row = matrix.row(v);
+        for (int u = 0; u < n; u++)
+        {
+          if (u == v)
+            continue;
+          m_minimum[v] += std::min(row[u], matrix(u, v));
+          m_total[v] += row[u];
+        }
+      },
+      64);
+  std::mt19937_64 random(Environment::seed());
+  m_zobrist.resize(n);
+  for (uint64_t &z : m_zobrist)
+  {
+    z = random();
+  }
+
+  Prefix root;
+  root.placed.assign(n, false);
+  root.cost.assign(n, 0), root.reverse.assign(n, 0), root.spent.assign(n, 0);
+  root.crossings = 0, root.pending = 0, root.bound = 0, root.hash = 0;
+  for (long long minimum : m_minimum)
+  {
+    root.bound += minimum;
+  }
+  root.bound /= 2;
+  std::vector<Prefix> beam = {root};
+
+  auto better = [](const Extension &a, const Extension &b) {
+    if (a.score != b.score)
+      return a.score < b.score;
+    if (a.rank != b.rank)
+      return a.rank < b.rank;
+    return a.parent < b.parent;
+  };
+  const utils::Deadline &deadline = Environment::deadline();
+  for (int depth = 0; depth < n && !deadline.expired(); depth++)
+  {
+    /** A global top 'width' has at most 'width' extensions of each prefix */
+    std::vector<std::vector<Extension>> extensions(beam.size());
+    library::ThreadPool::global().parallelFor(0, beam.size(), [&](int p) {
+      auto &candidates = extensions[p];
+      for (int v = 0; v < n; v++)
+      {
+        if (!beam[p].placed[v])
+          candidates.push_back(extend(beam[p], p, v));
+      }
+      int keep = std::min<int>(m_width, candidates.size());
+      std::partial_sort(candidates.begin(), candidates.begin() + keep,
+                        candidates.end(), better);
+      candidates.resize(keep);
+    });
+
+    std::vector<Extension> candidates;
+    for (const auto &e : extensions)
+    {
+      candidates.insert(candidates.end(), e.begin(), e.end());
+    }
+    std::sort(candidates.begin(), candidates.end(), better);
+    std::vector<Extension> chosen;
+    std::unordered_set<uint64_t> seen;
+    for (const Extension &e : candidates)
+    {
+      if ((int)chosen.size() == m_width)
+        break;
+      if (seen.insert(beam[e.parent].hash ^ m_zobrist[e.v]).second)
+        chosen.push_back(e);
+    }
+
+    std::vector<Prefix> next(chosen.size());
+    library::ThreadPool::global().parallelFor(0, chosen.size(), [&](int c) {
+      next[c] = beam[chosen[c].parent];
+      apply(next[c], chosen[c]);
+    });
+    beam = std::move(next);
+  }
+
+  /** The beam is sorted by score, and complete prefixes score their cost */
+  Prefix &best = beam.front();
+  if ((int)best.order.size() < n)
+  {
+    for (int v : start)
+    {
+      if (!best.placed[v - m_offset])
+        best.order.push_back(v);
+    }
+    best.crossings = numberOfCrossings(best.order);
+  }
+  m_order = best.order;
+  return best.crossings;
+}
+
+} // namespace beam
+} // namespace heuristic
+} // namespace solver
+} // namespace banana
@@ -0,0 +1,106 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   Alan Prado
+ *
+ * This file is part of Banana, a one-sided crossing minimization solver.
+ *
+ * Copyright (c) 2024 by the authors listed in the file AUTHORS in the
+ * top-level source directory and their institutional affiliations. All rights
+ * reserved. See the file LICENSE.md in the top-level source directory for
+ * licensing information.
+ * ****************************************************************************
+ *
+ * Beam search over prefixes of orders.
+ */
+
+#ifndef __PACE2024__BEAM_SEARCH_H
+#define __PACE2024__BEAM_SEARCH_H
+
+#include "approximation_routine.h"
+#include "dense_crossing_matrix.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace banana {
+namespace solver {
+namespace heuristic {
+namespace beam {
+
+/**
+ * Beam search
+ *
+ * Builds the order from left to right. Appending v to a prefix with vertex
+ * set S adds cost(v, S) = \sum_{u \in S} c_{u,v} crossings, as in the subset
+ * DP, so a prefix knows its exact crossings. The pairs between S and the
+ * other vertices T are decided as well, and cost \sum_{v \in T} cost(v, S).
+ * The score of a prefix adds both to the optimistic bound
+ * \sum min(c_{u,v}, c_{v,u}) over the pairs inside T. Each prefix keeps
+ * cost(v, S), \sum_{u \in S} c_{v,u} and the part of the bound of v already
+ * spent for every vertex v, so both the score of an extension and the update
+ * of a kept one are O(1) per vertex.
+ *
+ * At each depth the extensions of every prefix are scored on the thread pool,
+ * prefixes with the same vertex set are merged by a Zobrist hash of the set,
+ * and the best 'width' ones are kept. Ties go to the barycenter order. It
+ * runs in O(width * n^2) time and needs a DenseCrossingMatrix; if the
+ * deadline expires, the best prefix is completed in barycenter order.
+ */
+class BeamSearch : public ApproximationRoutine
+{
+public:
+  BeamSearch(
+      graph::BipartiteGraph graph,
+      std::shared_ptr<const crossing::DenseCrossingMatrix> matrix = nullptr);
+  ~BeamSearch() override = default;
+  long long solve() override;
+
+  /** Prefixes kept at each depth; a time versus quality knob */
+  void setWidth(int width);
+
+protected:
+  /** A prefix of an order. Vectors are indexed by vertex - m_offset. */
+  struct Prefix
+  {
+    std::vector<int> order;
+    std::vector<char> placed;
+    /** cost(v, S), and the crossings of v before S */
+    std::vector<long long> cost, reverse;
+    /** \sum_{u \in S} min(c_{u,v}, c_{v,u}) */
+    std::vector<long long> spent;
+    long long crossings;
+    /** \sum_{v \in T} cost(v, S) */
+    long long pending;
+    /** Bound on the crossings among the vertices not placed yet */
+    long long bound;
+    uint64_t hash;
+  };
+  /** Appending vertex 'v' (index in B) to the prefix 'parent' */
+  struct Extension
+  {
+    long long score;
+    int rank;
+    int parent, v;
+  };
+
+  Extension extend(const Prefix &prefix, int parent, int v) const;
+  /** Appends the vertex of 'extension' to 'prefix' */
+  void apply(Prefix &prefix, const Extension &extension) const;
+
+  int m_offset;
+  std::shared_ptr<const crossing::DenseCrossingMatrix> m_matrix;
+  int m_width;
+  /** Position of each vertex in the barycenter order, for ties */
+  std::vector<int> m_rank;
+  /** \sum_u min(c_{u,v}, c_{v,u}) and \sum_u c_{v,u} over all the others */
+  std::vector<long long> m_minimum, m_total;
+  std::vector<uint64_t> m_zobrist;
+};
+
+} // namespace beam
+} // namespace heuristic
+} // namespace solver
+} // namespace banana
+
+#endif // __PACE2024__BEAM_SEARCH_H
@@ -0,0 +1,142 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   Alan Prado
+ *
+ * This file is part of Banana, a one-sided crossing minimization solver.
+ *
+ * Copyright (c) 2024 by the authors listed in the file AUTHORS in the
+ * top-level source directory and their institutional affiliations. All rights
+ * reserved. See the file LICENSE.md in the top-level source directory for
+ * licensing information.
+ * ****************************************************************************
+ *
+ * Local search over moves of contiguous blocks.
+ */
+
+#include "block_move.h"
+#include "environment.h"
+
+#include <algorithm>
+
+namespace banana {
+namespace solver {
+namespace heuristic {
+namespace blockmove {
+
+const int WINDOW = 256;
+const int MAX_LENGTH = 16;
+
+BlockMove::BlockMove(
+    graph::BipartiteGraph graph,
+    std::shared_ptr<const crossing::DenseCrossingMatrix> matrix)
+    : ImprovementRoutine(graph), m_matrix(matrix)
+{
+  if (m_matrix == nullptr)
+    m_matrix = std::make_shared<crossing::DenseCrossingMatrix>(graph);
+}
+
+long long BlockMove::optimize(std::vector<int> &order, int begin,
+                              int end) const
+{
+  const crossing::DenseCrossingMatrix &matrix = *m_matrix;
+  int w = end - begin;
+  std::vector<int> index(w);
+  for (int p = 0; p < w; p++)
+  {
+    index[p] = order[begin + p] - m_offset;
+  }
+
+  /** prefix[p][q] = \sum D_{p',q'} over p' < p, q' < q, for p' < q' */
+  int stride = w + 1;
+  std::vector<long long> prefix(stride * stride, 0);
+  int valid = 0; // rows and columns up to 'valid' are up to date
+  auto update = [&]() {
+    for (int p = 1; p <= w; p++)
+    {
+      for (int q = p <= valid ? valid + 1 : 1; q <= w; q++)
+      {
+        int u = index[p - 1], v = index[q - 1];
+        long long d = p < q ? (long long)matrix(v, u) - matrix(u, v) : 0;
+        prefix[p * stride + q] = d + prefix[(p - 1) * stride + q] +
+                                 prefix[p * stride + q - 1] -
+                                 prefix[(p - 1) * stride + q - 1];
+      }
+    }
+    valid = w;
+  };
+  /** \sum D_{p,q} over p in [r1, r2], q in [c1, c2] */
+  auto rectangle = [&](int r1, int r2, int c1, int c2) {
+    return prefix[(r2 + 1) * stride + c2 + 1] - prefix[r1 * stride + c2 + 1] -
+           prefix[(r2 + 1) * stride + c1] + prefix[r1 * stride + c1];
+  };
+
+  const utils::Deadline &deadline = Environment::deadline();
+  long long total = 0;
+  bool improved = true;
+  while (improved && !deadline.expired())
+  {
+    improved = false;
+    for (int i = 0; i < w; i++)
+    {
+      for (int j = i; j < w && j < i + MAX_LENGTH; j++)
+      {
+        if (valid < w)
+          update();
+        /** Best target: after position k > j, or before position k < i */
+        long long best = 0;
+        int target = -1;
+        for (int k = j + 1; k < w; k++)
+        {
+          long long delta = rectangle(i, j, j + 1, k);
+          if (delta < best)
+            best = delta, target = k;
+        }
+        for (int k = 0; k < i; k++)
+        {
+          long long delta = rectangle(k, i - 1, i, j);
+          if (delta < best)
+            best = delta, target = k;
+        }
+        if (target == -1)
+          continue;
+
+        if (target > j)
+        {
+          std::rotate(index.begin() + i, index.begin() + j + 1,
+                      index.begin() + target + 1);
+          valid = std::min(valid, i);
+        }
+        else
+        {
+          std::rotate(index.begin() + target, index.begin() + i,
+                      index.begin() + j + 1);
+          valid = std::min(valid, target);
+        }
+        total += best, improved = true;
+      }
+    }
+  }
+
+  for (int p = 0; p < w; p++)
+  {
+    order[begin + p] = index[p] + m_offset;
+  }
+  return total;
+}
+
+long long BlockMove::improve(std::vector<int> &order, long long crossings)
+{
+  crossings += improveBlocks(order.size(), WINDOW,
+                             [&](int, int begin, int end) {
+                               return optimize(order, begin, end);
+                             });
+
+  m_order = order;
+  publish(m_order, crossings);
+  return crossings;
+}
+
+} // namespace blockmove
+} // namespace heuristic
+} // namespace solver
+} // namespace banana
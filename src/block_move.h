@@ -0,0 +1,74 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   Alan Prado
+ *
+ * This file is part of Banana, a one-sided crossing minimization solver.
+ *
+ * Copyright (c) 2024 by the authors listed in the file AUTHORS in the
+ * top-level source directory and their institutional affiliations. All rights
+ * reserved. See the file LICENSE.md in the top-level source directory for
+ * licensing information.
+ * ****************************************************************************
+ *
+ * Local search over moves of contiguous blocks.
+ */
+
+#ifndef __PACE2024__BLOCK_MOVE_H
+#define __PACE2024__BLOCK_MOVE_H
+
+#include "dense_crossing_matrix.h"
+#include "improvement_routine.h"
+
+#include <memory>
+#include <vector>
+
+namespace banana {
+namespace solver {
+namespace heuristic {
+namespace blockmove {
+
+/**
+ * Block move (Or-opt)
+ *
+ * Moves a segment of at most MAX_LENGTH consecutive vertices, as one unit,
+ * to another position. Moving the segment [i, j] after position k flips
+ * every pair (u, v) with u in [i, j] and v in [j + 1, k], so its change in
+ * crossings is the sum of D_{p,q} = c_{o_q,o_p} - c_{o_p,o_q} over a
+ * rectangle of positions, and likewise for moves to the left. With 2D
+ * prefix sums of D, every move is evaluated in O(1).
+ *
+ * The prefix sums are quadratic in the number of positions, so the search
+ * runs on the blocks of WINDOW positions of ImprovementRoutine::improveBlocks.
+ * After a move, the prefix sums are only marked stale from the first position
+ * it changed, and recomputed from there when the next move is evaluated.
+ * Each block takes the best move of each segment until none improves.
+ *
+ * Looks up a DenseCrossingMatrix, which is built unless one is given, so
+ * DenseCrossingMatrix::fits() must hold.
+ */
+class BlockMove : public ImprovementRoutine
+{
+public:
+  BlockMove(
+      graph::BipartiteGraph graph,
+      std::shared_ptr<const crossing::DenseCrossingMatrix> matrix = nullptr);
+  ~BlockMove() override = default;
+  using ImprovementRoutine::improve;
+  long long improve(std::vector<int> &order, long long crossings) override;
+
+protected:
+  /**
+   * Improves order[begin, end) with block moves inside it. Returns the
+   * change in crossings.
+   */
+  long long optimize(std::vector<int> &order, int begin, int end) const;
+
+  std::shared_ptr<const crossing::DenseCrossingMatrix> m_matrix;
+};
+
+} // namespace blockmove
+} // namespace heuristic
+} // namespace solver
+} // namespace banana
+
+#endif // __PACE2024__BLOCK_MOVE_H
@@ -16,6 +16,7 @@
 #include "crossing_matrix.h"
 #include "bipartite_graph.h"
 #include <algorithm>
+#include <climits>
 #include <stdexcept>
 #include <vector>
 #include <unordered_set>
@@ -45,6 +46,16 @@ CrossingMatrix::getIntervals(const graph::BipartiteGraph &graph)
   return {l, r};
 }
 
+bool CrossingMatrix::forcedBefore(int u, int lu, int ru, int v, int lv,
+                                  int rv)
+{
+  if (lu == lv && ru == rv && lu == ru)
+  {
+    return u < v; // free pair, decided by the order of the vertices
+  }
+  return ru <= lv;
+}
+
 CrossingMatrix::CrossingMatrix(graph::BipartiteGraph graph)
 {
   /* Computes the naive interval system */
@@ -153,5 +164,91 @@ std::vector<std::pair<int, int>> CrossingMatrix::getOrientablePairs()
   return res;
 }
 
+std::pair<long long, long long>
+CrossingMatrix::pairCrossings(const std::vector<int> &nu,
+                              const std::vector<int> &nv)
+{
+  /* u before v crosses every edge of v that ends strictly before one of u */
+  long long uv = 0, vu = 0;
+  for (int i = 0, j = 0; i < (int)nu.size(); i++)
+  {
+    while (j < (int)nv.size() && nv[j] < nu[i])
+      j++;
+    uv += j;
+  }
+  for (int i = 0, j = 0; i < (int)nv.size(); i++)
+  {
+    while (j < (int)nu.size() && nu[j] < nv[i])
+      j++;
+    vu += j;
+  }
+  return {uv, vu};
+}
+
+std::vector<std::vector<int>>
+CrossingMatrix::sortedNeighborhoods(const graph::BipartiteGraph &graph)
+{
+  int offset = graph.countVerticesA();
+  std::vector<std::vector<int>> result(graph.countVerticesB());
+  for (int v : graph.getB())
+  {
+    auto &neighbors = result[v - offset];
+    neighbors = graph.neighborhood(v);
+    std::sort(neighbors.begin(), neighbors.end());
+  }
+  return result;
+}
+
+OrientablePairs::OrientablePairs(
+    const graph::BipartiteGraph &graph,
+    const std::vector<std::pair<int, int>> &pairs)
+    : m_offset(graph.countVerticesA())
+{
+  int n = graph.countVerticesB();
+  auto intervals = CrossingMatrix::getIntervals(graph);
+  m_left.resize(n), m_right.resize(n);
+  for (int v : graph.getB())
+  {
+    m_left[v - m_offset] = intervals[0][v];
+    m_right[v - m_offset] = intervals[1][v];
+  }
+
+  for (auto [i, j] : pairs)
+  {
+    if (i < j)
+      m_pairs.push_back({i, j});
+  }
+  std::sort(m_pairs.begin(), m_pairs.end());
+  m_adjacency.resize(n);
+  for (int p = 0; p < (int)m_pairs.size(); p++)
+  {
+    auto [i, j] = m_pairs[p];
+    m_adjacency[i - m_offset].push_back({j, p});
+    m_adjacency[j - m_offset].push_back({i, p});
+  }
+  for (auto &neighbors : m_adjacency)
+  {
+    std::sort(neighbors.begin(), neighbors.end());
+  }
+}
+
+int OrientablePairs::index(int u, int v) const
+{
+  const auto &neighbors = m_adjacency[u - m_offset];
+  auto it = std::lower_bound(neighbors.begin(), neighbors.end(),
+                             std::make_pair(v, INT_MIN));
+  if (it == neighbors.end() || it->first != v)
+    return -1;
+  return it->second;
+}
+
+bool OrientablePairs::forcedBefore(int u, int v) const
+{
+  return CrossingMatrix::forcedBefore(u, m_left[u - m_offset],
+                                      m_right[u - m_offset], v,
+                                      m_left[v - m_offset],
+                                      m_right[v - m_offset]);
+}
+
 } // namespace crossing
 } // namespace banana
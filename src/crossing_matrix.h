@@ -19,6 +19,8 @@
 #include "bipartite_graph.h"
 #include <unordered_map>
 #include <map>
+#include <utility>
+#include <vector>
 
 namespace banana {
 namespace crossing {
@@ -33,7 +35,26 @@ public:
   int operator()(int u, int v) const;
   static std::vector<std::unordered_map<int, int>>
   getIntervals(const graph::BipartiteGraph &graph);
+  /**
+   * Whether the intervals [lu, ru] and [lv, rv] spanned by the neighborhoods
+   * of u and v force u before v. Vertices whose neighborhoods are the same
+   * single vertex (or empty) are free and follow the order of their ids;
+   * orientable pairs are forced neither way.
+   */
+  static bool forcedBefore(int u, int lu, int ru, int v, int lv, int rv);
   std::vector<std::pair<int, int>> getOrientablePairs();
+  /**
+   * Returns (c_{u,v}, c_{v,u}) for any pair of vertices, given their sorted
+   * neighborhoods. Linear in the degrees; no matrix is needed.
+   */
+  static std::pair<long long, long long>
+  pairCrossings(const std::vector<int> &nu, const std::vector<int> &nv);
+  /**
+   * Sorted neighborhood of each vertex v of B, as pairCrossings takes them,
+   * indexed by v - countVerticesA().
+   */
+  static std::vector<std::vector<int>>
+  sortedNeighborhoods(const graph::BipartiteGraph &graph);
 
 protected:
   /* Is this the best way to hash pairs? It works fine assuming size_t is 8
@@ -49,6 +70,38 @@ protected:
   std::unordered_map<std::pair<int, int>, int, pair_hash> m_map;
 };
 
+/**
+ * Orientable pairs (i, j), i < j, of the B vertices of a graph, indexed by
+ * their position in sorted order as in the lp_solve models.
+ */
+class OrientablePairs
+{
+public:
+  OrientablePairs(const graph::BipartiteGraph &graph,
+                  const std::vector<std::pair<int, int>> &pairs);
+  ~OrientablePairs() = default;
+
+  const std::vector<std::pair<int, int>> &pairs() const { return m_pairs; }
+  int size() const { return m_pairs.size(); }
+  /** Number of B vertices */
+  int countVertices() const { return m_adjacency.size(); }
+  /** Index of the orientable pair {u, v}, or -1 */
+  int index(int u, int v) const;
+  /** Orientable neighbors of 'v', as (neighbor, pair index), sorted */
+  const std::vector<std::pair<int, int>> &neighbors(int v) const
+  {
+    return m_adjacency[v - m_offset];
+  }
+  /** Whether u before v is forced by the intervals (see forcedBefore) */
+  bool forcedBefore(int u, int v) const;
+
+protected:
+  int m_offset;
+  std::vector<int> m_left, m_right;
+  std::vector<std::pair<int, int>> m_pairs;
+  std::vector<std::vector<std::pair<int, int>>> m_adjacency;
+};
+
 } // namespace crossing
 } // namespace banana
 
@@ -0,0 +1,76 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   Alan Prado
+ *
+ * This file is part of Banana, a one-sided crossing minimization solver.
+ *
+ * Copyright (c) 2024 by the authors listed in the file AUTHORS in the
+ * top-level source directory and their institutional affiliations. All rights
+ * reserved. See the file LICENSE.md in the top-level source directory for
+ * licensing information.
+ * ****************************************************************************
+ *
+ * Monotonic deadline.
+ */
+
+#ifndef __PACE2024__DEADLINE_HPP
+#define __PACE2024__DEADLINE_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <stdexcept>
+
+namespace banana {
+namespace utils {
+
+/** Thrown by long computations when the deadline has passed */
+class TimeLimitExceeded : public std::runtime_error
+{
+public:
+  TimeLimitExceeded() : std::runtime_error("Time limit exceeded") {}
+};
+
+/**
+ * Point in time, measured with the monotonic clock, after which solvers
+ * should stop. A default-constructed deadline never expires.
+ */
+class Deadline
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  Deadline() : m_set(false) {}
+  /** Expires 'seconds' from now */
+  Deadline(double seconds)
+      : m_set(true),
+        m_end(Clock::now() + std::chrono::duration_cast<Clock::duration>(
+                                 std::chrono::duration<double>(seconds)))
+  {}
+
+  bool isSet() const { return m_set; }
+  bool expired() const { return m_set && Clock::now() >= m_end; }
+  /** Seconds until expiration, or infinity if not set */
+  double remaining() const
+  {
+    if (!m_set)
+      return std::numeric_limits<double>::infinity();
+    std::chrono::duration<double> left = m_end - Clock::now();
+    return std::max(0.0, left.count());
+  }
+  /** Throws TimeLimitExceeded if expired */
+  void check() const
+  {
+    if (expired())
+      throw TimeLimitExceeded();
+  }
+
+protected:
+  bool m_set;
+  Clock::time_point m_end;
+};
+
+} // namespace utils
+} // namespace banana
+
+#endif // __PACE2024__DEADLINE_HPP
@@ -0,0 +1,82 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   Alan Prado
+ *
+ * This file is part of Banana, a one-sided crossing minimization solver.
+ *
+ * Copyright (c) 2024 by the authors listed in the file AUTHORS in the
+ * top-level source directory and their institutional affiliations. All rights
+ * reserved. See the file LICENSE.md in the top-level source directory for
+ * licensing information.
+ * ****************************************************************************
+ *
+ * Dense crossing matrix.
+ */
+
+#include "dense_crossing_matrix.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <climits>
+
+namespace banana {
+namespace crossing {
+
+/** At most 128MB of entries */
+const size_t MAX_ENTRIES = (size_t)1 << 25;
+
+bool DenseCrossingMatrix::fits(const graph::BipartiteGraph &graph)
+{
+  size_t n = graph.countVerticesB();
+  long long max_degree = 0;
+  for (int v : graph.getB())
+  {
+    max_degree = std::max<long long>(max_degree, graph.degree(v));
+  }
+  return n * n <= MAX_ENTRIES && max_degree * max_degree <= INT_MAX;
+}
+
+DenseCrossingMatrix::DenseCrossingMatrix(const graph::BipartiteGraph &graph)
+    : m_size(graph.countVerticesB())
+{
+  int offset = graph.countVerticesA();
+  std::vector<std::vector<int>> neighbors(m_size);
+  for (int v : graph.getB())
+  {
+    neighbors[v - offset] = graph.neighborhood(v);
+  }
+
+  /**
+   * With less[x] neighbors of u before each x in A, u before v crosses the
+   * edges of v ending strictly before a neighbor of u.
+   */
+  m_matrix.resize((size_t)m_size * m_size);
+  library::ThreadPool::global().parallelFor(
+      0, m_size,
+      [&](int u) {
+        int du = neighbors[u].size();
+        std::vector<int> less(offset + 1);
+        for (int a : neighbors[u])
+        {
+          less[a + 1]++;
+        }
+        for (int a = 1; a <= offset; a++)
+        {
+          less[a] += less[a - 1];
+        }
+        int *row = &m_matrix[(size_t)u * m_size];
+        for (int v = 0; v < m_size; v++)
+        {
+          int uv = 0;
+          for (int b : neighbors[v])
+          {
+            uv += du - less[b + 1];
+          }
+          row[v] = u == v ? 0 : uv;
+        }
+      },
+      16);
+}
+
+} // namespace crossing
+} // namespace banana
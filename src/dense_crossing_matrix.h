@@ -0,0 +1,57 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   Alan Prado
+ *
+ * This file is part of Banana, a one-sided crossing minimization solver.
+ *
+ * Copyright (c) 2024 by the authors listed in the file AUTHORS in the
+ * top-level source directory and their institutional affiliations. All rights
+ * reserved. See the file LICENSE.md in the top-level source directory for
+ * licensing information.
+ * ****************************************************************************
+ *
+ * Dense crossing matrix.
+ */
+
+#ifndef __PACE2024__DENSE_CROSSING_MATRIX_H
+#define __PACE2024__DENSE_CROSSING_MATRIX_H
+
+#include "bipartite_graph.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace banana {
+namespace crossing {
+
+/**
+ * Crossing numbers c_{u,v} of every pair of vertices of B, orientable or not,
+ * in a row-major array. Vertices are given as indexes in B (vertex - |A|).
+ * Unlike CrossingMatrix, lookups are a single load, which is what local
+ * searches need; the price is |B|^2 integers, so check fits() first.
+ */
+class DenseCrossingMatrix
+{
+public:
+  DenseCrossingMatrix(const graph::BipartiteGraph &graph);
+  ~DenseCrossingMatrix() = default;
+
+  /** Whether the matrix of 'graph' is small enough to be built */
+  static bool fits(const graph::BipartiteGraph &graph);
+
+  int operator()(int u, int v) const
+  {
+    return m_matrix[(size_t)u * m_size + v];
+  }
+  const int *row(int u) const { return &m_matrix[(size_t)u * m_size]; }
+  int size() const { return m_size; }
+
+protected:
+  int m_size;
+  std::vector<int> m_matrix;
+};
+
+} // namespace crossing
+} // namespace banana
+
+#endif // __PACE2024__DENSE_CROSSING_MATRIX_H
@@ -0,0 +1,264 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   Alan Prado
+ *
+ * This file is part of Banana, a one-sided crossing minimization solver.
+ *
+ * Copyright (c) 2024 by the authors listed in the file AUTHORS in the
+ * top-level source directory and their institutional affiliations. All rights
+ * reserved. See the file LICENSE.md in the top-level source directory for
+ * licensing information.
+ * ****************************************************************************
+ *
+ * Eades-Lin-Smyth heuristic on the penalty digraph.
+ */
+
+#include "eades_lin_smyth.h"
+#include "barycenter_heuristic.h"
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <set>
+
+namespace banana {
+namespace solver {
+namespace heuristic {
+namespace eadeslinsmyth {
+
+/** Orientable pairs above which fits() fails */
+const long long MAX_PAIRS = 1 << 24;
+
+EadesLinSmyth::EadesLinSmyth(graph::BipartiteGraph graph,
+                             std::shared_ptr<crossing::CrossingMatrix> cm)
+    : ApproximationRoutine(graph), m_offset(graph.countVerticesA()), m_cm(cm)
+{
+  int n = graph.countVerticesB();
+  auto intervals = crossing::CrossingMatrix::getIntervals(graph);
+  m_left.resize(n), m_right.resize(n);
+  for (int v : graph.getB())
+  {
+    m_left[v - m_offset] = intervals[0][v];
+    m_right[v - m_offset] = intervals[1][v];
+  }
+}
+
+bool EadesLinSmyth::fits(const graph::BipartiteGraph &graph)
+{
+  /**
+   * Pairs whose intervals overlap, counted as all pairs minus those where
+   * one interval ends before the other starts
+   */
+  std::vector<int> left, right;
+  for (int v : graph.getB())
+  {
+    const auto &neighbors = graph.neighborhood(v);
+    if (neighbors.empty())
+      continue;
+    auto [l, r] = std::minmax_element(neighbors.begin(), neighbors.end());
+    left.push_back(*l), right.push_back(*r);
+  }
+  long long m = left.size();
+  long long pairs = m * (m - 1) / 2;
+  std::sort(right.begin(), right.end());
+  for (int k = 0; k < (int)m; k++)
+  {
+    pairs -= std::upper_bound(right.begin(), right.end(), left[k]) -
+             right.begin();
+  }
+  return pairs <= MAX_PAIRS;
+}
+
+std::vector<int> EadesLinSmyth::greedyOrder(const std::vector<int> &start)
+{
+  int n = m_graph.countVerticesB();
+  std::vector<int> rank(n);
+  for (int i = 0; i < n; i++)
+  {
+    rank[start[i] - m_offset] = i;
+  }
+
+  /** Arcs leaving and entering each vertex, as (vertex, weight) */
+  std::vector<std::vector<std::pair<int, long long>>> out(n), in(n);
+  std::vector<long long> out_weight(n), in_weight(n);
+  for (auto [i, j] : m_cm->getOrientablePairs())
+  {
+    if (i > j)
+      continue;
+    long long w = (long long)(*m_cm)(j, i) - (*m_cm)(i, j);
+    int u = i - m_offset, v = j - m_offset;
+    if (w < 0)
+      std::swap(u, v), w = -w;
+    if (w == 0)
+      continue;
+    out[u].push_back({v, w}), in[v].push_back({u, w});
+    out_weight[u] += w, in_weight[v] += w;
+  }
+
+  /**
+   * Buckets of in - out, so the first vertex has the largest out - in, and
+   * the earliest in 'start' among those
+   */
+  std::set<std::pair<long long, int>> buckets;
+  std::vector<int> sinks, sources;
+  auto bucket = [&](int v) {
+    return std::make_pair(in_weight[v] - out_weight[v], rank[v]);
+  };
+  for (int i = n - 1; i >= 0; i--)
+  {
+    int v = start[i] - m_offset;
+    buckets.insert(bucket(v));
+    if (out_weight[v] == 0)
+      sinks.push_back(v);
+    else if (in_weight[v] == 0)
+      sources.push_back(v);
+  }
+
+  std::vector<char> removed(n);
+  auto update = [&](int u, long long out_change, long long in_change) {
+    buckets.erase(bucket(u));
+    out_weight[u] -= out_change, in_weight[u] -= in_change;
+    buckets.insert(bucket(u));
+    if (out_change > 0 && out_weight[u] == 0)
+      sinks.push_back(u);
+    if (in_change > 0 && in_weight[u] == 0)
+      sources.push_back(u);
+  };
+  auto remove = [&](int v) {
+    removed[v] = true;
+    buckets.erase(bucket(v));
+    for (auto [u, w] : out[v])
+    {
+      if (!removed[u])
+        update(u, 0, w);
+    }
+    for (auto [u, w] : in[v])
+    {
+      if (!removed[u])
+        update(u, w, 0);
+    }
+  };
+
+  std::vector<int> head, tail;
+  while (!buckets.empty())
+  {
+    int v;
+    if (!sinks.empty())
+    {
+      v = sinks.back(), sinks.pop_back();
+      if (removed[v])
+        continue;
+      tail.push_back(v);
+    }
+    else if (!sources.empty())
+    {
+      v = sources.back(), sources.pop_back();
+      if (removed[v])
+        continue;
+      head.push_back(v);
+    }
+    else
+    {
+      v = start[buckets.begin()->second] - m_offset;
+      head.push_back(v);
+    }
+    remove(v);
+  }
+
+  head.insert(head.end(), tail.rbegin(), tail.rend());
+  for (int &v : head)
+  {
+    v += m_offset;
+  }
+  return head;
+}
+
+std::vector<int> EadesLinSmyth::repair(const std::vector<int> &order) const
+{
+  int n = order.size();
+  std::vector<int> rank(n);
+  for (int i = 0; i < n; i++)
+  {
+    rank[order[i] - m_offset] = i;
+  }
+
+  /**
+   * u is forced before v iff right(u) <= left(v), except for two vertices
+   * with the same single neighbor, which are twins. Sorted by right end, with
+   * single neighbors last among equal ends, the forced predecessors of every
+   * vertex (and its twins, which it does not need) form a prefix.
+   */
+  auto key = [&](int v) {
+    return std::make_pair(m_right[v], m_left[v] == m_right[v]);
+  };
+  std::vector<int> by_right;
+  for (int v = 0; v < n; v++)
+  {
+    if (m_left[v] != -1)
+      by_right.push_back(v);
+  }
+  std::sort(by_right.begin(), by_right.end(),
+            [&](int u, int v) { return key(u) < key(v); });
+  std::vector<std::pair<int, bool>> keys;
+  for (int v : by_right)
+  {
+    keys.push_back(key(v));
+  }
+
+  /** Length of the prefix of by_right that must be placed before v */
+  std::vector<int> need(n, 0);
+  for (int v : by_right)
+  {
+    std::pair<int, bool> point = {m_left[v], true};
+    need[v] = m_left[v] == m_right[v]
+                  ? std::lower_bound(keys.begin(), keys.end(), point) -
+                        keys.begin()
+                  : std::upper_bound(keys.begin(), keys.end(), point) -
+                        keys.begin();
+  }
+  std::vector<int> by_need(n);
+  for (int v = 0; v < n; v++)
+  {
+    by_need[v] = v;
+  }
+  std::sort(by_need.begin(), by_need.end(),
+            [&](int u, int v) { return need[u] < need[v]; });
+
+  std::vector<int> res;
+  std::vector<char> placed(n);
+  std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>,
+                      std::greater<std::pair<int, int>>>
+      available;
+  for (int prefix = 0, next = 0; (int)res.size() < n;)
+  {
+    while (next < n && need[by_need[next]] <= prefix)
+    {
+      int v = by_need[next++];
+      available.push({rank[v], v});
+    }
+    int v = available.top().second;
+    available.pop();
+    res.push_back(v + m_offset);
+    placed[v] = true;
+    while (prefix < (int)by_right.size() && placed[by_right[prefix]])
+      prefix++;
+  }
+  return res;
+}
+
+long long EadesLinSmyth::solve()
+{
+  if (m_cm == nullptr)
+    m_cm = std::make_shared<crossing::CrossingMatrix>(m_graph);
+  barycenter::BarycenterHeuristic barycenter(m_graph);
+  barycenter.solve();
+  std::vector<int> start;
+  barycenter.explain(start);
+  m_order = repair(greedyOrder(start));
+  return numberOfCrossings(m_order);
+}
+
+} // namespace eadeslinsmyth
+} // namespace heuristic
+} // namespace solver
+} // namespace banana
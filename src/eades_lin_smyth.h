@@ -0,0 +1,81 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   Alan Prado
+ *
+ * This file is part of Banana, a one-sided crossing minimization solver.
+ *
+ * Copyright (c) 2024 by the authors listed in the file AUTHORS in the
+ * top-level source directory and their institutional affiliations. All rights
+ * reserved. See the file LICENSE.md in the top-level source directory for
+ * licensing information.
+ * ****************************************************************************
+ *
+ * Eades-Lin-Smyth heuristic on the penalty digraph.
+ */
+
+#ifndef __PACE2024__EADES_LIN_SMYTH_H
+#define __PACE2024__EADES_LIN_SMYTH_H
+
+#include "approximation_routine.h"
+#include "crossing_matrix.h"
+
+#include <memory>
+#include <vector>
+
+namespace banana {
+namespace solver {
+namespace heuristic {
+namespace eadeslinsmyth {
+
+/**
+ * Eades-Lin-Smyth heuristic
+ *
+ * The penalty digraph (Sugiyama's PM method) has an arc u -> v of weight
+ * c_{v,u} - c_{u,v} for every orientable pair where that is positive, so an
+ * order costs the weight of its backward arcs plus a constant. The greedy
+ * feedback arc set heuristic of Eades, Lin and Smyth builds the order from
+ * both ends: sinks go to the end, sources to the beginning, and otherwise
+ * the vertex of largest out-weight minus in-weight goes to the beginning,
+ * ties going to the barycenter order.
+ * Weights are unbounded, so the buckets of that difference are kept in an
+ * ordered set; the whole run is O((|pairs| + n) log n) after the pairs are
+ * known.
+ *
+ * Pairs that are not orientable have c_{u,v} = 0 for the orientation forced
+ * by the intervals of their neighborhoods, but they are not arcs of the
+ * digraph. The greedy order is then repaired into a linear extension of the
+ * interval order: vertices are placed one at a time, taking the earliest one
+ * in the greedy order among those whose forced predecessors are all placed.
+ *
+ * Needs the orientable pairs of a CrossingMatrix, which is built if none is
+ * given; check fits() first on large graphs.
+ */
+class EadesLinSmyth : public ApproximationRoutine
+{
+public:
+  EadesLinSmyth(graph::BipartiteGraph graph,
+                std::shared_ptr<crossing::CrossingMatrix> cm = nullptr);
+  ~EadesLinSmyth() override = default;
+  long long solve() override;
+
+  /** Whether the graph has few enough orientable pairs, roughly */
+  static bool fits(const graph::BipartiteGraph &graph);
+
+protected:
+  /** Greedy feedback arc set order, ties going to the earliest in 'start' */
+  std::vector<int> greedyOrder(const std::vector<int> &start);
+  /** Closest linear extension of the forced pairs to 'order' */
+  std::vector<int> repair(const std::vector<int> &order) const;
+
+  int m_offset;
+  std::shared_ptr<crossing::CrossingMatrix> m_cm;
+  /** Interval [m_left, m_right] of the neighborhood of each vertex of B */
+  std::vector<int> m_left, m_right;
+};
+
+} // namespace eadeslinsmyth
+} // namespace heuristic
+} // namespace solver
+} // namespace banana
+
+#endif // __PACE2024__EADES_LIN_SMYTH_H
@@ -16,13 +16,36 @@
 #include "environment.h"
 #include "options.h"
 
+#include <iostream>
+#include <random>
+
 namespace banana {
 
 void Environment::setOptions(int argc, char *argv[])
 {
   m_options.parseArguments(argc, argv);
+  if (m_options.general.timeLimit > 0)
+  {
+    m_deadline = utils::Deadline(m_options.general.timeLimit);
+  }
+  /** Drawn once, so that every heuristic logs the same seed */
+  m_seed = m_options.general.seed >= 0 ? m_options.general.seed
+                                       : std::random_device{}();
+  std::cerr << "seed: " << m_seed << std::endl;
 }
 
 options::Options Environment::options() { return m_options; }
 
+const utils::Deadline &Environment::deadline() { return m_deadline; }
+
+unsigned long long Environment::seed() { return m_seed; }
+
+Environment::TimeSlice::TimeSlice(double seconds) : m_previous(m_deadline)
+{
+  if (m_deadline.remaining() > seconds)
+    m_deadline = utils::Deadline(seconds);
+}
+
+Environment::TimeSlice::~TimeSlice() { m_deadline = m_previous; }
+
 } // namespace banana
@@ -16,6 +16,7 @@
 #ifndef __PACE2024__ENVIRONMENT_HPP
 #define __PACE2024__ENVIRONMENT_HPP
 
+#include "deadline.h"
 #include "options.h"
 
 #include <memory>
@@ -29,9 +30,34 @@ public:
   ~Environment() = default;
   static void setOptions(int argc, char *argv[]);
   static options::Options options();
+  /**
+   * Deadline of the run, set by the 'time-limit' flag, or of the innermost
+   * TimeSlice if that expires first
+   */
+  static const utils::Deadline &deadline();
+  /** Seed of the randomized heuristics, set by the 'seed' flag */
+  static unsigned long long seed();
+
+  /**
+   * While alive, deadline() expires at most 'seconds' after its creation, so
+   * that routines which only poll deadline() can be given a time share.
+   * Slices nest. Not thread-safe: create and destroy them while no other
+   * thread reads the deadline.
+   */
+  class TimeSlice
+  {
+  public:
+    TimeSlice(double seconds);
+    ~TimeSlice();
+
+  protected:
+    utils::Deadline m_previous;
+  };
 
 protected:
   static inline options::Options m_options = options::Options();
+  static inline utils::Deadline m_deadline = utils::Deadline();
+  static inline unsigned long long m_seed = 0;
 };
 
 } // namespace banana
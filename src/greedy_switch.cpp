@@ -0,0 +1,81 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   Alan Prado
+ *
+ * This file is part of Banana, a one-sided crossing minimization solver.
+ *
+ * Copyright (c) 2024 by the authors listed in the file AUTHORS in the
+ * top-level source directory and their institutional affiliations. All rights
+ * reserved. See the file LICENSE.md in the top-level source directory for
+ * licensing information.
+ * ****************************************************************************
+ *
+ * Parallel greedy switch.
+ */
+
+#include "greedy_switch.h"
+#include "environment.h"
+#include "thread_pool.h"
+
+#include <numeric>
+
+namespace banana {
+namespace solver {
+namespace heuristic {
+namespace exchange {
+
+GreedySwitch::GreedySwitch(
+    graph::BipartiteGraph graph,
+    std::shared_ptr<const crossing::DenseCrossingMatrix> matrix)
+    : ImprovementRoutine(graph), m_matrix(matrix)
+{
+  if (m_matrix == nullptr)
+    m_matrix = std::make_shared<crossing::DenseCrossingMatrix>(graph);
+}
+
+long long GreedySwitch::improve(std::vector<int> &order, long long crossings)
+{
+  const utils::Deadline &deadline = Environment::deadline();
+  int n = order.size();
+  std::vector<int> index(n);
+  for (int k = 0; k < n; k++)
+  {
+    index[k] = order[k] - m_offset;
+  }
+
+  const crossing::DenseCrossingMatrix &matrix = *m_matrix;
+  std::vector<long long> gain(n / 2);
+  int quiet = 0;
+  for (int phase = 0; quiet < 2 && !deadline.expired(); phase ^= 1)
+  {
+    int pairs = (n - phase) / 2;
+    library::ThreadPool::global().parallelFor(
+        0, pairs,
+        [&](int s) {
+          int k = phase + 2 * s;
+          int u = index[k], v = index[k + 1];
+          long long g = (long long)matrix(u, v) - matrix(v, u);
+          gain[s] = g > 0 ? g : 0;
+          if (g > 0)
+            std::swap(index[k], index[k + 1]);
+        },
+        4096);
+
+    long long total = std::accumulate(gain.begin(), gain.begin() + pairs, 0ll);
+    crossings -= total;
+    quiet = total > 0 ? 0 : quiet + 1;
+  }
+
+  for (int k = 0; k < n; k++)
+  {
+    order[k] = index[k] + m_offset;
+  }
+  m_order = order;
+  publish(m_order, crossings);
+  return crossings;
+}
+
+} // namespace exchange
+} // namespace heuristic
+} // namespace solver
+} // namespace banana
@@ -0,0 +1,59 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   Alan Prado
+ *
+ * This file is part of Banana, a one-sided crossing minimization solver.
+ *
+ * Copyright (c) 2024 by the authors listed in the file AUTHORS in the
+ * top-level source directory and their institutional affiliations. All rights
+ * reserved. See the file LICENSE.md in the top-level source directory for
+ * licensing information.
+ * ****************************************************************************
+ *
+ * Parallel greedy switch.
+ */
+
+#ifndef __PACE2024__GREEDY_SWITCH_H
+#define __PACE2024__GREEDY_SWITCH_H
+
+#include "dense_crossing_matrix.h"
+#include "improvement_routine.h"
+
+#include <memory>
+#include <vector>
+
+namespace banana {
+namespace solver {
+namespace heuristic {
+namespace exchange {
+
+/**
+ * Greedy switch (Eades and Kelly), as an odd-even transposition sort
+ *
+ * Even phases look at the pairs of positions (0, 1), (2, 3), ..., and odd
+ * phases at (1, 2), (3, 4), .... The pairs of a phase are disjoint, so all of
+ * them are swapped at once, on the thread pool, whenever c_{v,u} < c_{u,v}.
+ * Phases alternate until two in a row swap nothing. Each test is two loads
+ * from a DenseCrossingMatrix, which is built unless one is given, so
+ * DenseCrossingMatrix::fits() must hold.
+ */
+class GreedySwitch : public ImprovementRoutine
+{
+public:
+  GreedySwitch(
+      graph::BipartiteGraph graph,
+      std::shared_ptr<const crossing::DenseCrossingMatrix> matrix = nullptr);
+  ~GreedySwitch() override = default;
+  using ImprovementRoutine::improve;
+  long long improve(std::vector<int> &order, long long crossings) override;
+
+protected:
+  std::shared_ptr<const crossing::DenseCrossingMatrix> m_matrix;
+};
+
+} // namespace exchange
+} // namespace heuristic
+} // namespace solver
+} // namespace banana
+
+#endif // __PACE2024__GREEDY_SWITCH_H
@@ -0,0 +1,97 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   Alan Prado
+ *
+ * This file is part of Banana, a one-sided crossing minimization solver.
+ *
+ * Copyright (c) 2024 by the authors listed in the file AUTHORS in the
+ * top-level source directory and their institutional affiliations. All rights
+ * reserved. See the file LICENSE.md in the top-level source directory for
+ * licensing information.
+ * ****************************************************************************
+ *
+ * Definition of an abstract improvement routine class for heuristics
+ */
+
+#include "improvement_routine.h"
+#include "crossing_matrix.h"
+
+#include <algorithm>
+
+namespace banana {
+namespace solver {
+namespace heuristic {
+
+/** A perturbation moves one vertex in PERTURBATION_RATE, by a few positions */
+const int PERTURBATION_RATE = 16;
+const int PERTURBATION_DISTANCE = 8;
+
+ImprovementRoutine::ImprovementRoutine(graph::BipartiteGraph graph)
+    : ApproximationRoutine(graph), m_offset(graph.countVerticesA()),
+      m_neighbors(crossing::CrossingMatrix::sortedNeighborhoods(graph))
+{
+}
+
+long long ImprovementRoutine::solve()
+{
+  std::vector<int> order = m_graph.getB();
+  return improve(order);
+}
+
+long long ImprovementRoutine::improve(std::vector<int> &order)
+{
+  return improve(order, numberOfCrossings(order));
+}
+
+long long
+ImprovementRoutine::flip(int u, int v,
+                         const crossing::DenseCrossingMatrix *matrix) const
+{
+  u -= m_offset, v -= m_offset;
+  if (matrix != nullptr)
+    return (long long)(*matrix)(v, u) - (*matrix)(u, v);
+  auto [uv, vu] = crossing::CrossingMatrix::pairCrossings(m_neighbors[u],
+                                                          m_neighbors[v]);
+  return vu - uv;
+}
+
+long long
+ImprovementRoutine::perturb(std::vector<int> &order, std::mt19937_64 &random,
+                            const crossing::DenseCrossingMatrix *matrix) const
+{
+  int n = order.size();
+  long long delta = 0;
+  for (int s = 0; s < n / PERTURBATION_RATE + 1 && n >= 2; s++)
+  {
+    int distance = 1 + random() % std::min(PERTURBATION_DISTANCE, n - 1);
+    int from = random() % (n - distance);
+    int to = from + distance;
+    if (random() % 2)
+      std::swap(from, to);
+
+    int v = order[from];
+    if (from < to)
+    {
+      for (int k = from + 1; k <= to; k++)
+      {
+        delta += flip(v, order[k], matrix);
+      }
+      std::rotate(order.begin() + from, order.begin() + from + 1,
+                  order.begin() + to + 1);
+    }
+    else
+    {
+      for (int k = to; k < from; k++)
+      {
+        delta += flip(order[k], v, matrix);
+      }
+      std::rotate(order.begin() + to, order.begin() + from,
+                  order.begin() + from + 1);
+    }
+  }
+  return delta;
+}
+
+} // namespace heuristic
+} // namespace solver
+} // namespace banana
@@ -0,0 +1,122 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   Alan Prado
+ *
+ * This file is part of Banana, a one-sided crossing minimization solver.
+ *
+ * Copyright (c) 2024 by the authors listed in the file AUTHORS in the
+ * top-level source directory and their institutional affiliations. All rights
+ * reserved. See the file LICENSE.md in the top-level source directory for
+ * licensing information.
+ * ****************************************************************************
+ *
+ * Definition of an abstract improvement routine class for heuristics
+ */
+
+#ifndef __PACE2024__IMPROVEMENT_ROUTINE_H
+#define __PACE2024__IMPROVEMENT_ROUTINE_H
+
+#include "approximation_routine.h"
+#include "dense_crossing_matrix.h"
+#include "environment.h"
+#include "thread_pool.h"
+
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace banana {
+namespace solver {
+namespace heuristic {
+
+/**
+ * Abstract improvement routine class
+ *
+ * Heuristics that start from a complete order and make it better. solve()
+ * starts from the input order of B.
+ */
+class ImprovementRoutine : public ApproximationRoutine
+{
+public:
+  ImprovementRoutine(graph::BipartiteGraph graph);
+  virtual ~ImprovementRoutine() = default;
+  long long solve() override;
+
+  /** Improves 'order' in place and returns its number of crossings */
+  long long improve(std::vector<int> &order);
+  /** Same as above, when the crossings of 'order' are already known */
+  virtual long long improve(std::vector<int> &order, long long crossings) = 0;
+
+  /** Sorted neighborhood of the vertex 'v' of B */
+  const std::vector<int> &neighborhood(int v) const
+  {
+    return m_neighbors[v - m_offset];
+  }
+
+protected:
+  /**
+   * Change in crossings when u, right before v, goes right after it. Looks
+   * up 'matrix' if there is one, and merges the neighborhoods otherwise.
+   */
+  long long flip(int u, int v,
+                 const crossing::DenseCrossingMatrix *matrix) const;
+  /**
+   * Moves a few random vertices by a few positions. Returns the change in
+   * crossings.
+   */
+  long long perturb(std::vector<int> &order, std::mt19937_64 &random,
+                    const crossing::DenseCrossingMatrix *matrix) const;
+  /**
+   * Improves an order of 'n' positions by blocks of 'window' consecutive
+   * positions. Like the odd-even phases of GreedySwitch, phases alternate
+   * between blocks starting at 0 and blocks shifted by half a window. The
+   * blocks of a phase are disjoint, so optimize(phase, begin, end) runs on
+   * all of them at once on the thread pool, and returns the change in
+   * crossings of [begin, end). Phases go on until two in a row improve
+   * nothing or the deadline expires. Returns the total change.
+   */
+  template <class F>
+  long long improveBlocks(int n, int window, const F &optimize,
+                          int grain = 1) const;
+
+  int m_offset;
+  /** Sorted neighborhood of each vertex of B, indexed by vertex - m_offset */
+  std::vector<std::vector<int>> m_neighbors;
+};
+
+template <class F>
+long long ImprovementRoutine::improveBlocks(int n, int window,
+                                            const F &optimize,
+                                            int grain) const
+{
+  const utils::Deadline &deadline = Environment::deadline();
+  std::vector<long long> delta(n / window + 2);
+  long long change = 0;
+  int quiet = 0;
+  for (int phase = 0; quiet < 2 && n >= 2 && !deadline.expired(); phase ^= 1)
+  {
+    /** Block b covers [b window - shift, (b + 1) window - shift) */
+    int shift = phase * (window / 2);
+    int blocks = (n + shift + window - 1) / window;
+    library::ThreadPool::global().parallelFor(
+        0, blocks,
+        [&](int b) {
+          int begin = std::max(b * window - shift, 0);
+          int end = std::min((b + 1) * window - shift, n);
+          delta[b] = optimize(phase, begin, end);
+        },
+        grain);
+
+    long long total = std::accumulate(delta.begin(), delta.begin() + blocks,
+                                      0ll);
+    change += total;
+    quiet = total < 0 ? 0 : quiet + 1;
+  }
+  return change;
+}
+
+} // namespace heuristic
+} // namespace solver
+} // namespace banana
+
+#endif // __PACE2024__IMPROVEMENT_ROUTINE_H
@@ -0,0 +1,109 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   Alan Prado
+ *
+ * This file is part of Banana, a one-sided crossing minimization solver.
+ *
+ * Copyright (c) 2024 by the authors listed in the file AUTHORS in the
+ * top-level source directory and their institutional affiliations. All rights
+ * reserved. See the file LICENSE.md in the top-level source directory for
+ * licensing information.
+ * ****************************************************************************
+ *
+ * Best order known so far.
+ */
+
+#include "incumbent.h"
+
+#include <cerrno>
+#include <unistd.h>
+
+namespace banana {
+namespace solver {
+
+/** Characters of a vertex: up to 10 digits and a line break */
+const int CHARS_PER_VERTEX = 11;
+
+Incumbent::Incumbent(int size)
+{
+  m_slots[0].resize(size), m_slots[1].resize(size);
+  m_text.resize((size_t)size * CHARS_PER_VERTEX);
+}
+
+bool Incumbent::offer(const std::vector<int> &order, long long crossings)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_frozen.load())
+    return false;
+  int published = m_published.load();
+  if (published != -1 && m_slotCrossings[published] <= crossings)
+    return false;
+
+  int slot = published == 0 ? 1 : 0;
+  m_slots[slot] = order;
+  m_slotCrossings[slot] = crossings;
+  if (m_text.size() < order.size() * CHARS_PER_VERTEX)
+    m_text.resize(order.size() * CHARS_PER_VERTEX);
+  m_published.store(slot);
+  return true;
+}
+
+bool Incumbent::empty() const { return m_published.load() == -1; }
+
+long long Incumbent::crossings() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  int published = m_published.load();
+  return published == -1 ? -1 : m_slotCrossings[published];
+}
+
+std::vector<int> Incumbent::order() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  int published = m_published.load();
+  return published == -1 ? std::vector<int>() : m_slots[published];
+}
+
+bool Incumbent::writeOrder(int fd)
+{
+  if (m_written.exchange(true))
+    return false;
+  /** From now on no writer touches any slot */
+  m_frozen.store(true);
+  int published = m_published.load();
+  if (published == -1)
+    return false;
+
+  /** Only plain memory accesses and write(2) from here on */
+  const std::vector<int> &order = m_slots[published];
+  char *text = m_text.data();
+  size_t length = 0;
+  for (int vertex : order)
+  {
+    char digits[CHARS_PER_VERTEX];
+    int count = 0;
+    for (unsigned value = vertex + 1; value > 0 || count == 0; value /= 10)
+    {
+      digits[count++] = '0' + value % 10;
+    }
+    while (count > 0)
+    {
+      text[length++] = digits[--count];
+    }
+    text[length++] = '\n';
+  }
+
+  size_t written = 0;
+  while (written < length)
+  {
+    ssize_t result = write(fd, text + written, length - written);
+    if (result < 0 && errno != EINTR)
+      return false;
+    if (result > 0)
+      written += result;
+  }
+  return true;
+}
+
+} // namespace solver
+} // namespace banana
@@ -0,0 +1,74 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   Alan Prado
+ *
+ * This file is part of Banana, a one-sided crossing minimization solver.
+ *
+ * Copyright (c) 2024 by the authors listed in the file AUTHORS in the
+ * top-level source directory and their institutional affiliations. All rights
+ * reserved. See the file LICENSE.md in the top-level source directory for
+ * licensing information.
+ * ****************************************************************************
+ *
+ * Best order known so far.
+ */
+
+#ifndef __PACE2024__INCUMBENT_H
+#define __PACE2024__INCUMBENT_H
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace banana {
+namespace solver {
+
+/**
+ * Best order found by any solver, shared by all of them.
+ *
+ * Orders live in two preallocated slots. A new order is copied into the slot
+ * that is not published, and then published with a single atomic store, so
+ * readers never see a partial permutation. Writing the order out (see
+ * writeOrder) only reads the published slot and a preallocated text buffer,
+ * so it can be called from a signal handler.
+ */
+class Incumbent
+{
+public:
+  /** Preallocates room for orders of 'size' vertices */
+  Incumbent(int size = 0);
+  ~Incumbent() = default;
+
+  /**
+   * Keeps 'order' if it beats the current one. Returns whether it did.
+   * Thread-safe; it does nothing once the order was written.
+   */
+  bool offer(const std::vector<int> &order, long long crossings);
+
+  bool empty() const;
+  /** Crossings of the best order, or -1 if there is none */
+  long long crossings() const;
+  std::vector<int> order() const;
+
+  /**
+   * Writes the best order to 'fd', one vertex per line (1-based). Only the
+   * first call writes anything; it returns false for the others, and if there
+   * is no order. Async-signal-safe.
+   */
+  bool writeOrder(int fd);
+
+protected:
+  /** Serializes writers and readers, but not writeOrder */
+  mutable std::mutex m_mutex;
+  std::vector<int> m_slots[2];
+  long long m_slotCrossings[2] = {-1, -1};
+  std::atomic<int> m_published{-1};
+  std::atomic<bool> m_frozen{false};
+  std::atomic<bool> m_written{false};
+  std::vector<char> m_text;
+};
+
+} // namespace solver
+} // namespace banana
+
+#endif // __PACE2024__INCUMBENT_H
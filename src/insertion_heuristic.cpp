@@ -0,0 +1,116 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   Alan Prado
+ *
+ * This file is part of Banana, a one-sided crossing minimization solver.
+ *
+ * Copyright (c) 2024 by the authors listed in the file AUTHORS in the
+ * top-level source directory and their institutional affiliations. All rights
+ * reserved. See the file LICENSE.md in the top-level source directory for
+ * licensing information.
+ * ****************************************************************************
+ *
+ * Insertion heuristic for large instances.
+ */
+
+#include "insertion_heuristic.h"
+#include "environment.h"
+
+#include <algorithm>
+
+namespace banana {
+namespace solver {
+namespace heuristic {
+namespace insertion {
+
+/** Positions scanned past the best one before a direction is given up */
+const int PATIENCE = 64;
+
+InsertionHeuristic::InsertionHeuristic(graph::BipartiteGraph graph)
+    : ImprovementRoutine(graph)
+{}
+
+long long InsertionHeuristic::delta(int v, int u) const
+{
+  const auto &nv = m_neighbors[v];
+  long long dv = nv.size(), res = 0;
+  for (int b : m_neighbors[u])
+  {
+    auto [lo, hi] = std::equal_range(nv.begin(), nv.end(), b);
+    res += dv - 2 * (lo - nv.begin()) - (hi - lo);
+  }
+  return res;
+}
+
+long long InsertionHeuristic::insert(std::vector<int> &order,
+                                     std::vector<int> &position, int p)
+{
+  int n = order.size();
+  int v = order[p] - m_offset;
+  if (m_neighbors[v].empty())
+    return 0;
+
+  long long best = 0, sum = 0;
+  int target = p;
+  for (int k = p - 1, last = p; k >= 0 && last - k <= PATIENCE; k--)
+  {
+    sum += delta(v, order[k] - m_offset);
+    if (sum < best)
+      best = sum, target = k, last = k;
+  }
+  sum = 0;
+  for (int k = p + 1, last = p; k < n && k - last <= PATIENCE; k++)
+  {
+    sum -= delta(v, order[k] - m_offset);
+    if (sum < best)
+      best = sum, target = k, last = k;
+  }
+
+  if (target < p)
+    std::rotate(order.begin() + target, order.begin() + p,
+                order.begin() + p + 1);
+  else if (target > p)
+    std::rotate(order.begin() + p, order.begin() + p + 1,
+                order.begin() + target + 1);
+  for (int k = std::min(p, target); k <= std::max(p, target); k++)
+  {
+    position[order[k] - m_offset] = k;
+  }
+  return best;
+}
+
+long long InsertionHeuristic::improve(std::vector<int> &order,
+                                      long long crossings)
+{
+  const utils::Deadline &deadline = Environment::deadline();
+  std::vector<int> position(order.size());
+  for (int k = 0; k < (int)order.size(); k++)
+  {
+    position[order[k] - m_offset] = k;
+  }
+
+  bool improved = true;
+  while (improved && !deadline.expired())
+  {
+    improved = false;
+    std::vector<int> vertices = order;
+    for (int v : vertices)
+    {
+      if (deadline.expired())
+        break;
+      long long change = insert(order, position, position[v - m_offset]);
+      if (change < 0)
+        crossings += change, improved = true;
+    }
+    if (improved)
+      publish(order, crossings);
+  }
+
+  m_order = order;
+  return crossings;
+}
+
+} // namespace insertion
+} // namespace heuristic
+} // namespace solver
+} // namespace banana
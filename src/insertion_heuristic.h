@@ -0,0 +1,68 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   Alan Prado
+ *
+ * This file is part of Banana, a one-sided crossing minimization solver.
+ *
+ * Copyright (c) 2024 by the authors listed in the file AUTHORS in the
+ * top-level source directory and their institutional affiliations. All rights
+ * reserved. See the file LICENSE.md in the top-level source directory for
+ * licensing information.
+ * ****************************************************************************
+ *
+ * Insertion heuristic for large instances.
+ */
+
+#ifndef __PACE2024__INSERTION_HEURISTIC_H
+#define __PACE2024__INSERTION_HEURISTIC_H
+
+#include "improvement_routine.h"
+
+#include <vector>
+
+namespace banana {
+namespace solver {
+namespace heuristic {
+namespace insertion {
+
+/**
+ * Insertion heuristic
+ *
+ * Sifting for instances whose crossing matrix does not fit, and where even
+ * one O(|A| + |E|) pass per vertex is too slow. Each vertex v is taken out
+ * and reinserted at the best position found by scanning outwards from its
+ * current one. In each direction, the scan stops once PATIENCE positions in
+ * a row brought no new best position, so vertices that are close to their
+ * place cost little, and the ones that are far still travel.
+ *
+ * Moving v across u changes the crossings by
+ *
+ *   c_{v,u} - c_{u,v} = \sum_{b \in N(u)} d(v) - 2 |N(v) < b| - |N(v) = b|,
+ *
+ * and the counts come from binary searches over the sorted N(v). No crossing
+ * number is stored: memory is linear in |E|, and the deltas are exact.
+ */
+class InsertionHeuristic : public ImprovementRoutine
+{
+public:
+  InsertionHeuristic(graph::BipartiteGraph graph);
+  ~InsertionHeuristic() override = default;
+  using ImprovementRoutine::improve;
+  long long improve(std::vector<int> &order, long long crossings) override;
+
+protected:
+  /** c_{v,u} - c_{u,v}, for vertices of B given by index */
+  long long delta(int v, int u) const;
+  /**
+   * Moves order[p] to its best position. Returns the change in crossings,
+   * which is 0 if it stays.
+   */
+  long long insert(std::vector<int> &order, std::vector<int> &position, int p);
+};
+
+} // namespace insertion
+} // namespace heuristic
+} // namespace solver
+} // namespace banana
+
+#endif // __PACE2024__INSERTION_HEURISTIC_H
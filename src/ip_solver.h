@@ -17,9 +17,24 @@
 #define __PACE2024__IP_SOLVER_HPP
 
 #include "environment.h"
+#include "approximation_routine.h"
+#include "barycenter_heuristic.h"
 #include "bipartite_graph.h"
+#include "crossing_matrix.h"
+#include "eades_lin_smyth.h"
+#include "kwik_sort.h"
+#include "lagrangian_bound.h"
+#include "median_heuristic.h"
+#include "merge_sort_heuristic.h"
 #include "meta_solver.h"
+#include "orientation_probing.h"
+#include "portfolio.h"
+#include "sifting.h"
+#include "window_dp.h"
 
+#include <algorithm>
+#include <iostream>
+#include <memory>
 #include <stdexcept>
 
 namespace banana {
@@ -33,7 +48,12 @@ public:
   IntegerProgrammingSolverBase(graph::BipartiteGraph G)
       : MetaSolver<graph::BipartiteGraph, int>(G) {};
   ~IntegerProgrammingSolverBase() = default;
-  virtual int solve() = 0;
+  virtual long long solve() = 0;
+  /** Whether the last solve proved its order optimal */
+  bool provenOptimal() const { return m_provenOptimal; }
+
+protected:
+  bool m_provenOptimal = true;
 };
 
 /**
@@ -46,7 +66,15 @@ class IntegerProgrammingSolver : public IntegerProgrammingSolverBase
 public:
   IntegerProgrammingSolver(graph::BipartiteGraph G);
   ~IntegerProgrammingSolver() = default;
-  int solve() override;
+  long long solve() override;
+  /**
+   * Solves the next program as a subproblem of a larger search, such as a
+   * window of the large neighborhood search: 'order' gives the upper bound
+   * instead of the heuristics, the IP flags are ignored, and probing,
+   * Lagrangian fixing, cuts, LP-first, custom branching, rounding and logging
+   * are skipped.
+   */
+  void setSubproblem(const std::vector<int> &order);
 
 protected:
   /**
@@ -126,10 +154,33 @@ protected:
   virtual void xPrefix(T *program, U &vars) = 0;
   /** TODO: implement and explain? @mvkaio */
   virtual void yPrefix(T *program, U &vars) = 0;
+  /**
+   * Number of crossings of the best order found by the heuristics, used to
+   * cut the objective function of the formulations. The heuristics run as
+   * a portfolio (see portfolio.h), and the best order is kept in
+   * m_heuristicOrder, unless one was given by setSubproblem.
+   */
+  int heuristicUpperBound();
+  /**
+   * Orientations fixed with respect to 'upper_bound' by bound-based probing
+   * (see orientation_probing.h) and by reduced costs of the Lagrangian bound
+   * (see lagrangian_bound.h). Each pair (u, v) means that u precedes v.
+   * Empty unless the 'ipprobing' or 'iplagrangian' flags are set, and for
+   * subproblems.
+   */
+  std::vector<std::pair<int, int>>
+  fixOrientations(crossing::CrossingMatrix &cm, int upper_bound);
+  /** Whether fixOrientations may fix anything */
+  bool fixesOrientations() const;
   /** TODO: explain */
   std::pair<int, bool> triangularIndex(int i, int j);
   /** TODO: explain */
   int yIndex(int i, int j, int n, int offset);
+
+  /** Best order found by heuristicUpperBound, or the one given to it */
+  std::vector<int> m_heuristicOrder;
+  /** Set by setSubproblem */
+  bool m_subproblem = false;
 };
 
 template <class T, class U>
@@ -138,7 +189,15 @@ IntegerProgrammingSolver<T, U>::IntegerProgrammingSolver(
     : IntegerProgrammingSolverBase(graph)
 {}
 
-template <class T, class U> int IntegerProgrammingSolver<T, U>::solve()
+template <class T, class U>
+void IntegerProgrammingSolver<T, U>::setSubproblem(
+    const std::vector<int> &order)
+{
+  m_heuristicOrder = order;
+  m_subproblem = true;
+}
+
+template <class T, class U> long long IntegerProgrammingSolver<T, U>::solve()
 {
   options::HolderIP ip_options = Environment::options().ip;
   switch (ip_options.formulation)
@@ -161,6 +220,93 @@ template <class T, class U> int IntegerProgrammingSolver<T, U>::solve()
   throw std::runtime_error("Do the L");
 }
 
+template <class T, class U>
+int IntegerProgrammingSolver<T, U>::heuristicUpperBound()
+{
+  if (m_subproblem)
+  {
+    long long crossings = numberOfCrossings(m_heuristicOrder);
+    publish(m_heuristicOrder, crossings);
+    return crossings;
+  }
+
+  heuristic::portfolio::Portfolio portfolio(m_graph);
+  portfolio.setIncumbent(m_incumbent);
+
+  portfolio.addConstructive(
+      std::make_unique<heuristic::barycenter::BarycenterHeuristic>(m_graph));
+  portfolio.addConstructive(
+      std::make_unique<heuristic::median::MedianHeuristic>(m_graph));
+  portfolio.addConstructive(
+      std::make_unique<heuristic::mergesort::MergeSortHeuristic>(m_graph));
+  portfolio.addConstructive(
+      std::make_unique<heuristic::kwiksort::KwikSort>(m_graph));
+  if (heuristic::eadeslinsmyth::EadesLinSmyth::fits(m_graph))
+  {
+    portfolio.addConstructive(
+        std::make_unique<heuristic::eadeslinsmyth::EadesLinSmyth>(m_graph));
+  }
+  portfolio.addImprovement(
+      std::make_unique<heuristic::windowdp::WindowDP>(m_graph));
+  portfolio.addImprovement(
+      std::make_unique<heuristic::sifting::Sifting>(m_graph));
+
+  int best_heuristic_objective = portfolio.solve();
+  m_heuristicOrder.clear();
+  portfolio.explain(m_heuristicOrder);
+
+  return best_heuristic_objective;
+}
+
+template <class T, class U>
+std::vector<std::pair<int, int>>
+IntegerProgrammingSolver<T, U>::fixOrientations(crossing::CrossingMatrix &cm,
+                                                int upper_bound)
+{
+  const options::HolderIP &ip_options = Environment::options().ip;
+  std::vector<std::pair<int, int>> fixed;
+  if (m_subproblem)
+    return fixed;
+
+  if (ip_options.probingTimeLimit > 0)
+  {
+    OrientationProbing probing(m_graph, cm);
+    fixed = probing.run(upper_bound, ip_options.probingTimeLimit);
+    std::cerr << "probing: fixed " << fixed.size()
+              << " pairs, lower bound: " << probing.lowerBound()
+              << " upper bound: " << upper_bound << std::endl;
+  }
+
+  if (ip_options.lagrangianIterations > 0)
+  {
+    LagrangianBound lagrangian(m_graph, cm);
+    lagrangian.run(upper_bound, ip_options.lagrangianIterations);
+    std::vector<std::pair<int, int>> reduced =
+        lagrangian.fixOrientations(upper_bound);
+    std::cerr << "lagrangian: bound: " << lagrangian.bound()
+              << " triangles: " << lagrangian.multipliers().size()
+              << " fixed " << reduced.size() << " pairs" << std::endl;
+
+    /** Both fixings hold for every order within the upper bound */
+    std::sort(fixed.begin(), fixed.end());
+    for (auto fix : reduced)
+    {
+      if (!std::binary_search(fixed.begin(), fixed.end(), fix))
+        fixed.push_back(fix);
+    }
+  }
+
+  return fixed;
+}
+
+template <class T, class U>
+bool IntegerProgrammingSolver<T, U>::fixesOrientations() const
+{
+  const options::HolderIP &ip_options = Environment::options().ip;
+  return !m_subproblem && (ip_options.probingTimeLimit > 0 ||
+                           ip_options.lagrangianIterations > 0);
+}
+
 template <class T, class U>
 std::pair<int, bool> IntegerProgrammingSolver<T, U>::triangularIndex(int i,
                                                                      int j)
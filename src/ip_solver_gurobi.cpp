@@ -138,6 +138,20 @@ int GurobiSolver::shorter()
     }
   }
 
+  /** Orientations fixed by probing and reduced costs */
+  if (fixesOrientations())
+  {
+    crossing::CrossingMatrix crossing_matrix(m_graph);
+    int a_size = m_graph.countVerticesA();
+    for (auto [u, v] : fixOrientations(crossing_matrix, heuristicUpperBound()))
+    {
+      std::tie(index, b) = triangularIndex(u - a_size, v - a_size);
+      double value = !b ? 1 : 0;
+      variables[index].set(GRB_DoubleAttr_LB, value);
+      variables[index].set(GRB_DoubleAttr_UB, value);
+    }
+  }
+
   /** Prefix constraints */
   const auto &opt = Environment::options().ip.prefixConstraints;
   if (opt == options::IPPrefixConstraints::X ||
@@ -152,7 +166,20 @@ int GurobiSolver::shorter()
     yPrefix(&model, *variables);
   }
 
+  if (Environment::deadline().isSet())
+  {
+    model.set(GRB_DoubleParam_TimeLimit, Environment::deadline().remaining());
+  }
   model.optimize();
+  if (model.get(GRB_IntAttr_Status) != GRB_OPTIMAL)
+  {
+    if (model.get(GRB_IntAttr_SolCount) > 0)
+      m_provenOptimal = false;
+    else if (model.get(GRB_IntAttr_Status) == GRB_TIME_LIMIT)
+      throw utils::TimeLimitExceeded();
+    else
+      throw std::runtime_error("Gurobi found no solution\n");
+  }
 
   /**
    * Create vector with how many successors each vertex in B has.
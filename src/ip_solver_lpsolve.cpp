@@ -20,10 +20,17 @@
 #include "approximation_routine.h"
 #include "barycenter_heuristic.h"
 #include "crossing_matrix.h"
+#include "deadline.h"
+#include "environment.h"
+#include "lpsolve_branching.h"
+#include "lpsolve_rounding.h"
 #include "median_heuristic.h"
+#include "ordering_cuts.h"
 
+#include <cmath>
 #include <numeric>
 #include <stdexcept>
+#include <string>
 #include <iostream>
 
 namespace banana {
@@ -44,7 +51,6 @@ int search_pair(std::vector<std::pair<int, int>> &orientable_pairs,
 
 enum class PAIR_STATE
 {
-  FREE,
   OR,
   PRE,
   POS,
@@ -54,19 +60,16 @@ PAIR_STATE pair_state(std::unordered_map<int, int> &l,
                       std::unordered_map<int, int> &r,
                       std::pair<int, int> key)
 {
+  using crossing::CrossingMatrix;
   auto [i, j] = key;
 
-  if (l[i] == l[j] and r[i] == r[j] and l[i] == r[i])
+  if (CrossingMatrix::forcedBefore(i, l[i], r[i], j, l[j], r[j]))
   {
-    return PAIR_STATE::FREE;
+    return PAIR_STATE::PRE; // forced ij, or free and i < j
   }
-  else if (r[i] <= l[j])
+  else if (CrossingMatrix::forcedBefore(j, l[j], r[j], i, l[i], r[i]))
   {
-    return PAIR_STATE::PRE; // forced ij
-  }
-  else if (r[j] <= l[i])
-  {
-    return PAIR_STATE::POS; // forced ji
+    return PAIR_STATE::POS; // forced ji, or free and j < i
   }
   else
   {
@@ -74,6 +77,124 @@ PAIR_STATE pair_state(std::unordered_map<int, int> &l,
   }
 }
 
+/** Aborts lp_solve once the deadline of the run has passed */
+int __WINAPI abort_on_deadline(lprec *lp, void *handle)
+{
+  return Environment::deadline().expired() ? TRUE : FALSE;
+}
+
+/** Passes the deadline of the run to 'lp', if there is one */
+void limit_time(lprec *lp)
+{
+  const utils::Deadline &deadline = Environment::deadline();
+  if (!deadline.isSet())
+    return;
+  set_timeout(lp, std::max(1l, (long)std::ceil(deadline.remaining())));
+  put_abortfunc(lp, abort_on_deadline, nullptr);
+}
+
+/** Frees 'lp' and stops building the model if the deadline has passed */
+void check_deadline(lprec *lp)
+{
+  if (Environment::deadline().expired())
+  {
+    delete_lp(lp);
+    throw utils::TimeLimitExceeded();
+  }
+}
+
+/**
+ * Checks the 'result' of solving the 0-1 model 'lp'. Returns whether its
+ * solution is proven optimal. If lp_solve stopped before finding any solution,
+ * frees 'lp' and throws.
+ */
+bool check_result(lprec *lp, int result, const std::string &message)
+{
+  if (result == OPTIMAL || result == PRESOLVED)
+    return true;
+  if (result == SUBOPTIMAL)
+  {
+    std::cerr << "lp_solve: stopped early, using its best solution"
+              << std::endl;
+    return false;
+  }
+  delete_lp(lp);
+  if (Environment::deadline().expired())
+    throw utils::TimeLimitExceeded();
+  throw std::runtime_error(message);
+}
+
+/** Whether every value of 'x' is 0 or 1, up to lp_solve's tolerance */
+bool is_integral(const std::vector<double> &x)
+{
+  for (double value : x)
+  {
+    if (std::abs(value - std::round(value)) > 1e-7)
+      return false;
+  }
+  return true;
+}
+
+/**
+ * Whether the sorted numbers of successors 'sol' come from a linear order. A
+ * tournament is transitive iff every vertex has a distinct number of
+ * successors, that is, they are 0, 1, ..., n - 1.
+ */
+bool is_transitive(const std::vector<std::pair<int, int>> &sol)
+{
+  for (int k = 0; k < (int)sol.size(); k++)
+  {
+    if (sol[k].first != k)
+      return false;
+  }
+  return true;
+}
+
+/** Maximum number of ordering cuts added in a single round */
+const int MAX_CUTS_PER_ROUND = 200;
+
+/**
+ * Alternates between solving the LP relaxation of 'lp' and adding the
+ * ordering cuts it violates, for at most 'rounds' rounds. Logs the bound of
+ * every round.
+ */
+void ordering_cut_loop(lprec *lp, const OrderingCuts &separator, int rounds,
+                       int objective_offset)
+{
+  std::vector<double> x(get_Ncolumns(lp));
+  std::vector<int> columns;
+  double previous_bound = 0;
+  for (int round = 0; round < rounds; round++)
+  {
+    limit_time(lp);
+    if (::solve(lp) != OPTIMAL)
+      break;
+    get_variables(lp, x.data());
+    double bound = get_objective(lp) + objective_offset;
+    std::vector<OrderingCuts::Cut> cuts =
+        separator.separate(x, MAX_CUTS_PER_ROUND);
+
+    std::cerr << "cuts: round " << round << " bound: " << bound;
+    if (round > 0)
+      std::cerr << " (+" << bound - previous_bound << ")";
+    std::cerr << " added " << cuts.size() << std::endl;
+    previous_bound = bound;
+
+    if (cuts.empty())
+      break;
+    for (OrderingCuts::Cut &cut : cuts)
+    {
+      columns.clear();
+      for (int p : cut.pairs)
+      {
+        columns.push_back(p + 1); // Element 0 is ignored by LP Solve
+      }
+      add_constraintex(lp, columns.size(), cut.coefs.data(), columns.data(),
+                       LE, cut.rhs);
+    }
+  }
+}
+
 LPSolveSolver::LPSolveSolver(graph::BipartiteGraph graph)
     : IntegerProgrammingSolver<lprec, std::vector<double>>(graph)
 {}
@@ -116,24 +237,7 @@ int LPSolveSolver::simple()
 
   /** Heuristic constraints */
   // TODO: Create flag that controls whether this is active
-
-  std::vector<std::unique_ptr<heuristic::ApproximationRoutine>> heuristics;
-
-  // check barycenter heuristic
-  heuristics.push_back(std::make_unique<heuristic::barycenter::BarycenterHeuristic>(m_graph));
-  heuristics.push_back(std::make_unique<heuristic::median::MedianHeuristic>(m_graph));
-
-  int best_heuristic_objective = -1;
-
-  for (const auto& h : heuristics)
-  {
-    int obj = h->solve();
-    if (best_heuristic_objective == -1 ||
-        best_heuristic_objective > obj)
-    {
-      best_heuristic_objective = obj;
-    }
-  }
+  int best_heuristic_objective = heuristicUpperBound();
 
   // we add a constraint saying that the objective value (reusing the
   // values of from the objective loop) is less than or equal to the
@@ -146,6 +250,7 @@ int LPSolveSolver::simple()
   std::fill(c.begin(), c.end(), 0);
   for (int idx = 0; idx < number_vars; idx++)
   {
+    check_deadline(lp);
     auto [i, j] = orientable_pairs[idx];
     for (int k : m_graph.getB())
     {
@@ -181,9 +286,6 @@ int LPSolveSolver::simple()
         {
         case PAIR_STATE::OR:
           assert(false);
-        case PAIR_STATE::FREE:
-          forced_jk = j < k ? 1 : 0;
-          break;
         case PAIR_STATE::PRE:
           forced_jk = 1;
           break;
@@ -209,9 +311,6 @@ int LPSolveSolver::simple()
         {
         case PAIR_STATE::OR:
           assert(false);
-        case PAIR_STATE::FREE:
-          forced_ik = i < k ? 1 : 0;
-          break;
         case PAIR_STATE::PRE:
           forced_ik = 1;
           break;
@@ -269,9 +368,20 @@ int LPSolveSolver::simple()
     set_binary(lp, i, TRUE);
   }
 
-  if (number_vars > 0 and ::solve(lp))
+  /** Orientations fixed by probing and reduced costs: x_uv = 1, x_vu = 0 */
+  for (auto [u, v] : fixOrientations(cm, best_heuristic_objective))
+  {
+    int idx_uv = search_pair(orientable_pairs, {u, v}) + 1;
+    int idx_vu = search_pair(orientable_pairs, {v, u}) + 1;
+    set_bounds(lp, idx_uv, 1, 1);
+    set_bounds(lp, idx_vu, 0, 0);
+  }
+
+  limit_time(lp);
+  if (number_vars > 0)
   {
-    throw std::invalid_argument("Houston, we have a problem :-(\n");
+    m_provenOptimal =
+        check_result(lp, ::solve(lp), "Houston, we have a problem :-(\n");
   }
 
   /**
@@ -304,13 +414,7 @@ int LPSolveSolver::simple()
       }
       else
       {
-        if (st_ij == PAIR_STATE::FREE)
-        {
-          //  {i, j} is free, we suppose it is decided on the order of the
-          //  vertices
-          count_successors += i < j ? 1 : 0;
-        }
-        else if (st_ij == PAIR_STATE::PRE)
+        if (st_ij == PAIR_STATE::PRE)
         {
           // {i, j} is forced to ij
           count_successors++;
@@ -386,24 +490,7 @@ int LPSolveSolver::shorter()
 
   /** Heuristic constraints */
   // TODO: Create flag that controls whether this is active
-
-  std::vector<std::unique_ptr<heuristic::ApproximationRoutine>> heuristics;
-
-  // check barycenter heuristic
-  heuristics.push_back(std::make_unique<heuristic::barycenter::BarycenterHeuristic>(m_graph));
-  heuristics.push_back(std::make_unique<heuristic::median::MedianHeuristic>(m_graph));
-
-  int best_heuristic_objective = -1;
-
-  for (const auto& h : heuristics)
-  {
-    int obj = h->solve();
-    if (best_heuristic_objective == -1 ||
-        best_heuristic_objective > obj)
-    {
-      best_heuristic_objective = obj;
-    }
-  }
+  int best_heuristic_objective = heuristicUpperBound();
 
   // we add a constraint saying that the objective value (reusing the
   // values of from the objective loop) is less than or equal to the
@@ -411,12 +498,14 @@ int LPSolveSolver::shorter()
   add_constraint(lp, c.data(), LE, best_heuristic_objective - objective_offset);
 
 
-  /** Transitivity constraints */
+  /** Transitivity constraints, appended in row mode */
   std::fill(c.begin(), c.end(), 0);
+  set_add_rowmode(lp, TRUE);
   // NOTE: This iterates over orientable_pairs, not pairs, because it needs to
   // check both {i, j} and {j,i}
   for (auto [i, j] : orientable_pairs)
   {
+    check_deadline(lp);
     PAIR_STATE st_ij = pair_state(l, r, {i, j});
     assert (st_ij == PAIR_STATE::OR);
 
@@ -451,9 +540,6 @@ int LPSolveSolver::shorter()
 
       switch (st_jk)
       {
-        case PAIR_STATE::FREE:
-          if (j < k) rhs -= 1;
-          break;
         case PAIR_STATE::PRE:
           rhs -= 1;
           break;
@@ -467,9 +553,6 @@ int LPSolveSolver::shorter()
 
       switch (st_ik)
       {
-        case PAIR_STATE::FREE:
-          if (i < k) rhs += 1;
-          break;
         case PAIR_STATE::PRE:
           rhs += 1;
           break;
@@ -491,13 +574,22 @@ int LPSolveSolver::shorter()
         rhs -= 1;
       }
 
-      //std::cerr << "Add constraint" << std::endl;
-      add_constraint(lp, c.data(), LE, rhs);
+      /** Sparse row: a dense one costs O(#variables) per triangle */
+      int columns[3];
+      double values[3];
+      int count = 0;
+      for (int idx : {idx_ij, idx_jk, idx_ik})
+      {
+        if (idx > 0 && c[idx] != 0)
+          columns[count] = idx, values[count++] = c[idx];
+      }
+      add_constraintex(lp, count, values, columns, LE, rhs);
       c[idx_ij] = 0;
       c[idx_jk] = 0;
       c[idx_ik] = 0;
     }
   }
+  set_add_rowmode(lp, FALSE);
 
   /** Prefix constraints */
   // const auto &opt = Environment::options().ip.prefixConstraints;
@@ -509,92 +601,189 @@ int LPSolveSolver::shorter()
   // assert(opt != options::IPPrefixConstraints::Y);
   // assert(opt != options::IPPrefixConstraints::BOTH);
 
-  /** 0-1 variables constraint */
+  /** Relaxation of the 0-1 variables, tightened by set_binary below */
   for (int i = 1; i <= number_vars; i++)
   {
-    set_binary(lp, i, TRUE);
+    set_upbo(lp, i, 1);
+  }
+
+  /** Orientations fixed by probing and reduced costs: x_ij = 1 iff i first */
+  for (auto [u, v] : fixOrientations(cm, best_heuristic_objective))
+  {
+    int idx = search_pair(pairs, {std::min(u, v), std::max(u, v)}) + 1;
+    int value = u < v ? 1 : 0;
+    set_bounds(lp, idx, value, value);
   }
 
-  if (number_vars > 0 and ::solve(lp))
+  /** Ordering cuts, separated from the LP relaxation */
+  int cut_rounds = m_subproblem ? 0 : Environment::options().ip.cutRounds;
+  if (number_vars > 0 and cut_rounds > 0)
   {
-    throw std::runtime_error("Hate you LPSolve! ;-;\n");
+    OrderingCuts separator(m_graph, cm);
+    ordering_cut_loop(lp, separator, cut_rounds, objective_offset);
   }
 
   /**
-   * Create vector with how many successors each vertex in B has.
-   * Sort this vector and return the vertices in reverse order.
+   * Create vector with how many successors each vertex in B has, in the 0-1
+   * solution 'vars'.
    */
-  std::vector<double> vars(number_vars);
-  if (number_vars > 0)
-    get_variables(lp, vars.data());
-  std::vector<std::pair<int, int>> sol;
-  int pre, pos, ors, frees;
-  pre = pos = ors = frees = 0;
-  for (int i : m_graph.getB())
-  {
-    int count_successors = 0;
-    for (int j : m_graph.getB())
+  auto count_successors_of = [&](const std::vector<double> &vars) {
+    std::vector<std::pair<int, int>> sol;
+    int pre, pos, ors;
+    pre = pos = ors = 0;
+    for (int i : m_graph.getB())
     {
-      if (i == j)
-      {
-        continue;
-      }
-
-      PAIR_STATE st_ij = pair_state(l, r, {i, j});
-      if (st_ij == PAIR_STATE::OR)
-      {
-        ors++;
-        // pair is orientable, check IP solution
-
-
-        int idx_ij =  search_pair(pairs, {i, j});
-        int idx_ji = search_pair(pairs, {j, i});
-
-        if (i < j)
-        {
-          assert(idx_ij != -1);
-          assert(idx_ji == -1);
-          count_successors += vars[idx_ij];
-        }
-        else
-        {
-          assert(idx_ji != -1);
-          assert(idx_ij == -1);
-          count_successors += 1 - vars[idx_ji];
-        }
-      }
-      else
+      int count_successors = 0;
+      for (int j : m_graph.getB())
       {
-        if (st_ij == PAIR_STATE::FREE)
+        if (i == j)
         {
-          frees++;
-          //  {i, j} is free, we suppose it is decided on the order of the
-          //  vertices
-          count_successors += i < j ? 1 : 0;
-        }
-        else if (st_ij == PAIR_STATE::PRE)
-        {
-          pre++;
-          // {i, j} is forced to ij
-          count_successors++;
+          continue;
         }
-        else if (st_ij == PAIR_STATE::POS)
+
+        PAIR_STATE st_ij = pair_state(l, r, {i, j});
+        if (st_ij == PAIR_STATE::OR)
         {
-          pos++;
-          // {i, j} is forced to ji
-          continue;
+          ors++;
+          // pair is orientable, check IP solution
+
+
+          int idx_ij =  search_pair(pairs, {i, j});
+          int idx_ji = search_pair(pairs, {j, i});
+
+          if (i < j)
+          {
+            assert(idx_ij != -1);
+            assert(idx_ji == -1);
+            count_successors += std::lround(vars[idx_ij]);
+          }
+          else
+          {
+            assert(idx_ji != -1);
+            assert(idx_ij == -1);
+            count_successors += 1 - std::lround(vars[idx_ji]);
+          }
         }
         else
         {
-          assert(st_ij == PAIR_STATE::OR);
-          throw std::runtime_error("An orientable pair was not decided by the PI!\n");
+          if (st_ij == PAIR_STATE::PRE)
+          {
+            pre++;
+            // {i, j} is forced to ij
+            count_successors++;
+          }
+          else if (st_ij == PAIR_STATE::POS)
+          {
+            pos++;
+            // {i, j} is forced to ji
+            continue;
+          }
+          else
+          {
+            assert(st_ij == PAIR_STATE::OR);
+            throw std::runtime_error("An orientable pair was not decided by the PI!\n");
+          }
         }
       }
+      sol.push_back({count_successors, i});
     }
-    sol.push_back({count_successors, i});
+    //std::cerr << "N: " << n << " Pre: " << pre << " Pos: " << pos << " Ors: " << ors << std::endl;
+    std::sort(sol.begin(), sol.end());
+    return sol;
+  };
+
+  std::vector<double> vars(number_vars);
+  std::vector<std::pair<int, int>> sol;
+
+  /**
+   * LP-first: the relaxation is often integral, and then its solution is an
+   * optimal order and branch and bound can be skipped.
+   */
+  bool fast_path = false;
+  std::vector<int> basis;
+  std::unique_ptr<LPSolveRounding> rounding;
+  if (number_vars > 0 and !m_subproblem and Environment::options().ip.lpFirst)
+  {
+    limit_time(lp);
+    if (::solve(lp) == OPTIMAL)
+    {
+      get_variables(lp, vars.data());
+      fast_path = is_integral(vars);
+    }
+    if (fast_path)
+    {
+      sol = count_successors_of(vars);
+      fast_path = is_transitive(sol);
+    }
+    if (!fast_path)
+    {
+      basis.resize(1 + get_Nrows(lp) + get_Ncolumns(lp));
+      get_basis(lp, basis.data(), TRUE);
+    }
+    std::cerr << "lp-first: "
+              << (fast_path ? "integral relaxation, branch and bound skipped"
+                            : "fractional relaxation, branching")
+              << std::endl;
   }
-  //std::cerr << "N: " << n << " Pre: " << pre << " Pos: " << pos << " Free: " << frees << " Ors: " << ors << std::endl;
-  std::sort(sol.begin(), sol.end());
+
+  if (!fast_path)
+  {
+    /** 0-1 variables constraint */
+    for (int i = 1; i <= number_vars; i++)
+    {
+      set_binary(lp, i, TRUE);
+    }
+    /** Resume from the basis of the relaxation */
+    if (!basis.empty())
+    {
+      set_basis(lp, basis.data(), TRUE);
+    }
+
+    /** Branching strategy, guided by the costs and the heuristic order */
+    std::vector<int> position(n);
+    for (int k = 0; k < (int)m_heuristicOrder.size(); k++)
+    {
+      position[m_heuristicOrder[k] - m_graph.countVerticesA()] = k;
+    }
+    std::vector<double> costs(number_vars + 1);
+    std::vector<char> preferred(number_vars + 1);
+    for (int idx = 1; idx <= number_vars; idx++)
+    {
+      auto [i, j] = pairs[idx - 1];
+      costs[idx] = cm(i, j) - cm(j, i);
+      preferred[idx] = position[i - m_graph.countVerticesA()] <
+                       position[j - m_graph.countVerticesA()];
+    }
+    LPSolveBranching branching(m_subproblem
+                                   ? options::IPBranching::DEFAULT
+                                   : Environment::options().ip.branching,
+                               costs, preferred);
+    branching.attach(lp);
+    /** Rounds the relaxation at the root and every few nodes */
+    if (!m_subproblem)
+    {
+      rounding = std::make_unique<LPSolveRounding>(
+          m_graph, pairs, objective_offset, m_incumbent);
+      rounding->attach(lp);
+    }
+
+    limit_time(lp);
+    if (number_vars > 0)
+    {
+      m_provenOptimal =
+          check_result(lp, ::solve(lp), "Hate you LPSolve! ;-;\n");
+    }
+    if (number_vars > 0 and !m_subproblem)
+    {
+      std::cerr << "branching: explored " << get_total_nodes(lp) << " nodes"
+                << std::endl;
+    }
+    if (number_vars > 0)
+      get_variables(lp, vars.data());
+    sol = count_successors_of(vars);
+  }
+
+  /** Return the vertices in reverse order of successors */
   for (auto it = sol.rbegin(); it != sol.rend(); it++)
   {
     m_order.push_back(it->second);
@@ -602,7 +791,16 @@ int LPSolveSolver::shorter()
 
   double z = number_vars > 0 ? get_objective(lp) : 0;
   delete_lp(lp);
-  return round(z) + objective_offset; // Return optimal value
+  int objective = round(z) + objective_offset;
+
+  /** lp_solve may have stopped early with a worse order than a rounded one */
+  if (rounding != nullptr && rounding->crossings() != -1 &&
+      rounding->crossings() < objective)
+  {
+    m_order = rounding->order();
+    objective = rounding->crossings();
+  }
+  return objective; // Return optimal value
 }
 
 int LPSolveSolver::quadratic()
@@ -716,10 +914,9 @@ int LPSolveSolver::quadratic()
     set_binary(lp, i, TRUE);
   }
 
-  if (::solve(lp))
-  {
-    throw std::runtime_error("Houston, we have a problem :-(\n");
-  }
+  limit_time(lp);
+  m_provenOptimal =
+      check_result(lp, ::solve(lp), "Houston, we have a problem :-(\n");
 
   /**
    * Create vector with how many successors each vertex in B has.
@@ -976,10 +1173,9 @@ int LPSolveSolver::vini()
     set_binary(lp, i, TRUE);
   }
 
-  if (::solve(lp))
-  {
-    throw std::invalid_argument("Houston, we have a problem :-(\n");
-  }
+  limit_time(lp);
+  m_provenOptimal =
+      check_result(lp, ::solve(lp), "Houston, we have a problem :-(\n");
 
   /**
    * Create vector with how many successors each vertex in B has.
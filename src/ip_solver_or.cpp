@@ -151,6 +151,19 @@ int OrToolsSolver::shorter()
     }
   }
 
+  /** Orientations fixed by probing and reduced costs */
+  if (fixesOrientations())
+  {
+    crossing::CrossingMatrix crossing_matrix(m_graph);
+    int a_size = m_graph.countVerticesA();
+    for (auto [u, v] : fixOrientations(crossing_matrix, heuristicUpperBound()))
+    {
+      std::tie(index, b) = triangularIndex(u - a_size, v - a_size);
+      double value = !b ? 1 : 0;
+      variables[index]->SetBounds(value, value);
+    }
+  }
+
   /** Prefix constraints */
   // const auto& opt = Environment::options().ip.prefixConstraints;
   // if (opt == options::IPPrefixConstraints::X ||
@@ -165,10 +178,21 @@ int OrToolsSolver::shorter()
   //   yPrefix(model.get(), variables);
   // }
 
+  if (Environment::deadline().isSet())
+  {
+    model->SetTimeLimit(
+        absl::Milliseconds(1000 * Environment::deadline().remaining()));
+  }
   const MPSolver::ResultStatus result_status = model->Solve();
 
-  if (result_status != MPSolver::OPTIMAL)
+  if (result_status == MPSolver::FEASIBLE)
+  {
+    m_provenOptimal = false;
+  }
+  else if (result_status != MPSolver::OPTIMAL)
   {
+    if (Environment::deadline().expired())
+      throw utils::TimeLimitExceeded();
     throw std::runtime_error("Houston, we have a problem! :q\n");
   }
 
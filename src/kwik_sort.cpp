@@ -0,0 +1,124 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   Alan Prado
+ *
+ * This file is part of Banana, a one-sided crossing minimization solver.
+ *
+ * Copyright (c) 2024 by the authors listed in the file AUTHORS in the
+ * top-level source directory and their institutional affiliations. All rights
+ * reserved. See the file LICENSE.md in the top-level source directory for
+ * licensing information.
+ * ****************************************************************************
+ *
+ * KwikSort with crossing numbers as the comparator.
+ */
+
+#include "kwik_sort.h"
+#include "barycenter_heuristic.h"
+#include "crossing_matrix.h"
+#include "environment.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+
+namespace banana {
+namespace solver {
+namespace heuristic {
+namespace kwiksort {
+
+/** Ranges below this size are sorted by the calling thread alone */
+const int SEQUENTIAL_CUTOFF = 4096;
+const int PARTITION_GRAIN = 1024;
+
+KwikSort::KwikSort(graph::BipartiteGraph graph)
+    : ApproximationRoutine(graph), m_offset(graph.countVerticesA()),
+      m_neighbors(crossing::CrossingMatrix::sortedNeighborhoods(graph))
+{
+}
+
+bool KwikSort::before(int u, int v) const
+{
+  auto [uv, vu] = crossing::CrossingMatrix::pairCrossings(
+      m_neighbors[u - m_offset], m_neighbors[v - m_offset]);
+  if (uv != vu)
+    return uv < vu;
+  return m_rank[u - m_offset] < m_rank[v - m_offset];
+}
+
+void KwikSort::sort(int begin, int end)
+{
+  int size = end - begin;
+  if (size < 2)
+    return;
+
+  /** splitmix64 of the seed and the range */
+  unsigned long long z = Environment::seed() ^
+                         ((unsigned long long)begin << 32 | (unsigned)end);
+  z += 0x9e3779b97f4a7c15ull;
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+  z ^= z >> 31;
+  std::swap(m_order[begin], m_order[begin + z % size]);
+  int pivot = m_order[begin];
+
+  std::vector<char> left(size);
+  auto side = [&](int i) {
+    left[i] = before(m_order[begin + i], pivot);
+  };
+  if (size < SEQUENTIAL_CUTOFF)
+  {
+    for (int i = 1; i < size; i++)
+    {
+      side(i);
+    }
+  }
+  else
+  {
+    library::ThreadPool::global().parallelFor(1, size, side, PARTITION_GRAIN);
+  }
+
+  std::vector<int> lower, upper;
+  for (int i = 1; i < size; i++)
+  {
+    (left[i] ? lower : upper).push_back(m_order[begin + i]);
+  }
+  int middle = begin + lower.size();
+  std::copy(lower.begin(), lower.end(), m_order.begin() + begin);
+  m_order[middle] = pivot;
+  std::copy(upper.begin(), upper.end(), m_order.begin() + middle + 1);
+
+  if (size < SEQUENTIAL_CUTOFF)
+  {
+    sort(begin, middle);
+    sort(middle + 1, end);
+  }
+  else
+  {
+    library::ThreadPool::global().parallelFor(0, 2, [&](int s) {
+      if (s == 0)
+        sort(begin, middle);
+      else
+        sort(middle + 1, end);
+    });
+  }
+}
+
+long long KwikSort::solve()
+{
+  barycenter::BarycenterHeuristic barycenter(m_graph);
+  barycenter.solve();
+  barycenter.explain(m_order);
+  m_rank.resize(m_order.size());
+  for (int i = 0; i < (int)m_order.size(); i++)
+  {
+    m_rank[m_order[i] - m_offset] = i;
+  }
+
+  sort(0, m_order.size());
+  return numberOfCrossings(m_order);
+}
+
+} // namespace kwiksort
+} // namespace heuristic
+} // namespace solver
+} // namespace banana
@@ -0,0 +1,67 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   Alan Prado
+ *
+ * This file is part of Banana, a one-sided crossing minimization solver.
+ *
+ * Copyright (c) 2024 by the authors listed in the file AUTHORS in the
+ * top-level source directory and their institutional affiliations. All rights
+ * reserved. See the file LICENSE.md in the top-level source directory for
+ * licensing information.
+ * ****************************************************************************
+ *
+ * KwikSort with crossing numbers as the comparator.
+ */
+
+#ifndef __PACE2024__KWIK_SORT_H
+#define __PACE2024__KWIK_SORT_H
+
+#include "approximation_routine.h"
+
+#include <vector>
+
+namespace banana {
+namespace solver {
+namespace heuristic {
+namespace kwiksort {
+
+/**
+ * KwikSort (Ailon, Charikar and Newman)
+ *
+ * Quicksort with a random pivot p, where u goes to the left of p iff
+ * c_{u,p} < c_{p,u}. On tournaments this is an expected 3-approximation of
+ * the weighted feedback arc set, and each level costs one crossing number
+ * per vertex. Crossing numbers are computed when needed by merging the two
+ * sorted neighborhoods, so no matrix is built. Ties go to the barycenter
+ * order.
+ *
+ * Large ranges are partitioned on the thread pool, and both sides recurse in
+ * parallel. Pivots are drawn from a hash of Environment::seed() and the range,
+ * so the order does not depend on the scheduling of the threads.
+ */
+class KwikSort : public ApproximationRoutine
+{
+public:
+  KwikSort(graph::BipartiteGraph graph);
+  ~KwikSort() override = default;
+  long long solve() override;
+
+protected:
+  /** Whether u goes before v */
+  bool before(int u, int v) const;
+  /** Sorts m_order[begin, end) */
+  void sort(int begin, int end);
+
+  int m_offset;
+  /** Sorted neighborhood of each vertex of B, indexed by vertex - m_offset */
+  std::vector<std::vector<int>> m_neighbors;
+  /** Position in the barycenter order, for ties */
+  std::vector<int> m_rank;
+};
+
+} // namespace kwiksort
+} // namespace heuristic
+} // namespace solver
+} // namespace banana
+
+#endif // __PACE2024__KWIK_SORT_H
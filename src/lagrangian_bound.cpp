@@ -0,0 +1,282 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   Alan Prado
+ *
+ * This file is part of Banana, a one-sided crossing minimization solver.
+ *
+ * Copyright (c) 2024 by the authors listed in the file AUTHORS in the
+ * top-level source directory and their institutional affiliations. All rights
+ * reserved. See the file LICENSE.md in the top-level source directory for
+ * licensing information.
+ * ****************************************************************************
+ *
+ * Lagrangian relaxation of the transitivity constraints.
+ */
+
+#include "lagrangian_bound.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace banana {
+namespace solver {
+namespace ip {
+
+/** Iterations without improvement before the step size is halved */
+const int STALL_ITERATIONS = 20;
+const double EPSILON = 1e-6;
+
+LagrangianBound::LagrangianBound(const graph::BipartiteGraph &graph,
+                                 crossing::CrossingMatrix &cm)
+    : m_offset(graph.countVerticesA()), m_objectiveOffset(0),
+      m_pairs(graph, cm.getOrientablePairs()), m_bestBound(0)
+{
+  for (auto [i, j] : m_pairs.pairs())
+  {
+    m_costs.push_back(cm(i, j) - cm(j, i));
+    m_objectiveOffset += cm(j, i);
+  }
+
+  /** Bound with all multipliers at zero */
+  m_bestBound = m_objectiveOffset;
+  for (int cost : m_costs)
+  {
+    m_bestBound += std::min(cost, 0);
+  }
+}
+
+LagrangianBound::Triangle LagrangianBound::makeTriangle(int i, int j, int k,
+                                                        int type) const
+{
+  Triangle t;
+  t.vertices[0] = i, t.vertices[1] = j, t.vertices[2] = k;
+  int sign = type == 0 ? 1 : -1;
+  int base[3] = {sign, sign, -sign};
+  std::pair<int, int> ends[3] = {{i, j}, {j, k}, {i, k}};
+  t.rhs = type == 0 ? 1 : 0;
+  t.multiplier = 0;
+  for (int s = 0; s < 3; s++)
+  {
+    auto [u, v] = ends[s];
+    t.pairs[s] = m_pairs.index(u, v);
+    if (t.pairs[s] == -1)
+    {
+      t.coefs[s] = 0;
+      t.rhs -= base[s] * m_pairs.forcedBefore(u, v);
+    }
+    else
+    {
+      t.coefs[s] = base[s];
+    }
+  }
+  return t;
+}
+
+int LagrangianBound::separate(const std::vector<char> &x)
+{
+  int n = m_pairs.countVertices();
+  auto value = [&](int u, int v) {
+    int p = m_pairs.index(u, v);
+    return p == -1 ? m_pairs.forcedBefore(u, v) : x[p];
+  };
+  auto key = [&](int i, int j, int k, int type) {
+    uint64_t n64 = n;
+    return (((uint64_t)(i - m_offset) * n64 + (j - m_offset)) * n64 +
+            (k - m_offset)) *
+               2 +
+           type;
+  };
+
+  /**
+   * Every triple with at least two orientable pairs has a center adjacent to
+   * the other two vertices. It is enumerated from its smallest center only.
+   */
+  std::vector<std::vector<std::pair<std::vector<int>, int>>> found(n);
+  library::ThreadPool::global().parallelFor(
+      0, n,
+      [&](int c) {
+        int center = c + m_offset;
+        const auto &neighbors = m_pairs.neighbors(center);
+        for (int x1 = 0; x1 < (int)neighbors.size(); x1++)
+        {
+          for (int x2 = x1 + 1; x2 < (int)neighbors.size(); x2++)
+          {
+            int a = neighbors[x1].first, b = neighbors[x2].first;
+            if (center > a && m_pairs.index(a, b) != -1)
+              continue;
+            int v[3] = {a, b, center};
+            std::sort(v, v + 3);
+            int sum = value(v[0], v[1]) + value(v[1], v[2]);
+            int ik = value(v[0], v[2]);
+            for (int type = 0; type < 2; type++)
+            {
+              bool violated = type == 0 ? sum - ik > 1 : ik - sum > 0;
+              if (violated &&
+                  !m_triangleKeys.count(key(v[0], v[1], v[2], type)))
+              {
+                found[c].push_back({{v[0], v[1], v[2]}, type});
+              }
+            }
+          }
+        }
+      },
+      16);
+
+  int added = 0;
+  for (const auto &triangles : found)
+  {
+    for (const auto &[v, type] : triangles)
+    {
+      if (m_triangleKeys.insert(key(v[0], v[1], v[2], type)).second)
+      {
+        m_triangles.push_back(makeTriangle(v[0], v[1], v[2], type));
+        added++;
+      }
+    }
+  }
+  return added;
+}
+
+std::vector<double> LagrangianBound::reducedCosts() const
+{
+  std::vector<double> costs(m_costs.begin(), m_costs.end());
+  for (const Triangle &t : m_triangles)
+  {
+    if (t.multiplier == 0)
+      continue;
+    for (int s = 0; s < 3; s++)
+    {
+      if (t.pairs[s] != -1)
+        costs[t.pairs[s]] += t.multiplier * t.coefs[s];
+    }
+  }
+  return costs;
+}
+
+double LagrangianBound::run(int upper_bound, int iterations)
+{
+  double theta = 2;
+  int stall = 0;
+  std::vector<char> x(m_pairs.size());
+  std::vector<double> subgradient;
+
+  for (int it = 0; it < iterations; it++)
+  {
+    /** Solve the relaxation: every pair is independent */
+    std::vector<double> costs = reducedCosts();
+    double bound = m_objectiveOffset;
+    for (const Triangle &t : m_triangles)
+    {
+      bound -= t.multiplier * t.rhs;
+    }
+    for (int p = 0; p < m_pairs.size(); p++)
+    {
+      x[p] = costs[p] < 0;
+      bound += std::min(costs[p], 0.0);
+    }
+
+    if (bound > m_bestBound + EPSILON)
+    {
+      m_bestBound = bound;
+      m_bestMultipliers.resize(m_triangles.size());
+      for (int t = 0; t < (int)m_triangles.size(); t++)
+      {
+        m_bestMultipliers[t] = m_triangles[t].multiplier;
+      }
+      stall = 0;
+    }
+    else if (++stall >= STALL_ITERATIONS)
+    {
+      theta /= 2, stall = 0;
+    }
+    if (std::ceil(m_bestBound - EPSILON) >= upper_bound)
+      break;
+
+    separate(x);
+
+    /** Subgradient of the dualized constraints */
+    subgradient.assign(m_triangles.size(), 0);
+    library::ThreadPool::global().parallelFor(
+        0, m_triangles.size(),
+        [&](int t) {
+          const Triangle &triangle = m_triangles[t];
+          int lhs = 0;
+          for (int s = 0; s < 3; s++)
+          {
+            if (triangle.pairs[s] != -1)
+              lhs += triangle.coefs[s] * x[triangle.pairs[s]];
+          }
+          subgradient[t] = lhs - triangle.rhs;
+          if (triangle.multiplier == 0 && subgradient[t] < 0)
+            subgradient[t] = 0;
+        },
+        1024);
+
+    double norm = 0;
+    for (double g : subgradient)
+    {
+      norm += g * g;
+    }
+    if (norm == 0)
+      break; // the relaxed solution is feasible, so the bound is tight
+
+    /** Polyak step towards the upper bound */
+    double step = theta * (upper_bound - bound) / norm;
+    library::ThreadPool::global().parallelFor(
+        0, m_triangles.size(),
+        [&](int t) {
+          Triangle &triangle = m_triangles[t];
+          triangle.multiplier =
+              std::max(0.0, triangle.multiplier + step * subgradient[t]);
+        },
+        1024);
+  }
+
+  return m_bestBound;
+}
+
+double LagrangianBound::bound() const { return m_bestBound; }
+
+std::vector<std::pair<std::vector<int>, double>>
+LagrangianBound::multipliers() const
+{
+  std::vector<std::pair<std::vector<int>, double>> res;
+  for (int t = 0; t < (int)m_bestMultipliers.size(); t++)
+  {
+    if (m_bestMultipliers[t] == 0)
+      continue;
+    const int *v = m_triangles[t].vertices;
+    res.push_back({{v[0], v[1], v[2]}, m_bestMultipliers[t]});
+  }
+  return res;
+}
+
+std::vector<std::pair<int, int>>
+LagrangianBound::fixOrientations(int upper_bound) const
+{
+  std::vector<double> costs(m_costs.begin(), m_costs.end());
+  for (int t = 0; t < (int)m_bestMultipliers.size(); t++)
+  {
+    const Triangle &triangle = m_triangles[t];
+    for (int s = 0; s < 3; s++)
+    {
+      if (triangle.pairs[s] != -1)
+        costs[triangle.pairs[s]] += m_bestMultipliers[t] * triangle.coefs[s];
+    }
+  }
+
+  std::vector<std::pair<int, int>> fixed;
+  for (int p = 0; p < m_pairs.size(); p++)
+  {
+    if (std::ceil(m_bestBound + std::abs(costs[p]) - EPSILON) <= upper_bound)
+      continue;
+    auto [i, j] = m_pairs.pairs()[p];
+    fixed.push_back(costs[p] < 0 ? std::make_pair(i, j) : std::make_pair(j, i));
+  }
+  return fixed;
+}
+
+} // namespace ip
+} // namespace solver
+} // namespace banana
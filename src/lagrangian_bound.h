@@ -0,0 +1,111 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   Alan Prado
+ *
+ * This file is part of Banana, a one-sided crossing minimization solver.
+ *
+ * Copyright (c) 2024 by the authors listed in the file AUTHORS in the
+ * top-level source directory and their institutional affiliations. All rights
+ * reserved. See the file LICENSE.md in the top-level source directory for
+ * licensing information.
+ * ****************************************************************************
+ *
+ * Lagrangian relaxation of the transitivity constraints.
+ */
+
+#ifndef __PACE2024__LAGRANGIAN_BOUND_H
+#define __PACE2024__LAGRANGIAN_BOUND_H
+
+#include "bipartite_graph.h"
+#include "crossing_matrix.h"
+
+#include <cstdint>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace banana {
+namespace solver {
+namespace ip {
+
+/**
+ * Lagrangian bound
+ *
+ * Uses the variables of the shorter formulation: x_{i,j}, for each orientable
+ * pair i < j, is 1 iff i appears before j. For every triple i < j < k, the
+ * transitivity constraints are
+ *
+ *   x_{i,j} + x_{j,k} - x_{i,k} \leq 1   and   x_{i,k} - x_{i,j} - x_{j,k}
+ *   \leq 0,
+ *
+ * where pairs that are not orientable are replaced by their forced value.
+ * Dualizing them with multipliers \lambda \geq 0 leaves a problem in which
+ * every variable is independent, so it is solved by setting x_p = 1 iff its
+ * reduced cost is negative. The best bound over the multipliers is found by
+ * subgradient optimization.
+ *
+ * Only the triangles that were violated by some relaxed solution get a
+ * multiplier, so memory is proportional to the triangles that matter instead
+ * of all the O(n^3) constraints. Separation and multiplier updates run on the
+ * thread pool.
+ */
+class LagrangianBound
+{
+public:
+  LagrangianBound(const graph::BipartiteGraph &graph,
+                  crossing::CrossingMatrix &cm);
+  ~LagrangianBound() = default;
+
+  /**
+   * Runs at most 'iterations' subgradient steps, with step sizes aimed at
+   * 'upper_bound'. Returns the best bound found.
+   */
+  double run(int upper_bound, int iterations);
+
+  /** Best lower bound found so far */
+  double bound() const;
+  /** Multipliers of the best bound, as ((i, j, k), \lambda) with i < j < k */
+  std::vector<std::pair<std::vector<int>, double>> multipliers() const;
+  /**
+   * Reduced cost fixing with the best multipliers: if flipping x_p raises
+   * the bound above 'upper_bound', x_p keeps its relaxed value. Each pair
+   * (u, v) means that u precedes v.
+   */
+  std::vector<std::pair<int, int>> fixOrientations(int upper_bound) const;
+
+protected:
+  /** A dualized constraint: \sum coefs * x_pairs \leq rhs */
+  struct Triangle
+  {
+    int vertices[3];
+    int pairs[3]; // -1 if the pair is forced
+    int coefs[3];
+    int rhs;
+    double multiplier;
+  };
+
+  /** Builds constraint 'type' (0 or 1) of the triple i < j < k */
+  Triangle makeTriangle(int i, int j, int k, int type) const;
+  /** Adds the triangles violated by 'x' to the active set */
+  int separate(const std::vector<char> &x);
+  /** Reduced costs for the current multipliers */
+  std::vector<double> reducedCosts() const;
+
+  int m_offset;
+  long long m_objectiveOffset;
+  /** Orientable pairs (i, j), i < j, and c_{i,j} - c_{j,i} */
+  crossing::OrientablePairs m_pairs;
+  std::vector<int> m_costs;
+
+  std::vector<Triangle> m_triangles;
+  std::unordered_set<uint64_t> m_triangleKeys;
+
+  double m_bestBound;
+  std::vector<double> m_bestMultipliers;
+};
+
+} // namespace ip
+} // namespace solver
+} // namespace banana
+
+#endif // __PACE2024__LAGRANGIAN_BOUND_H
@@ -0,0 +1,165 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   Alan Prado
+ *
+ * This file is part of Banana, a one-sided crossing minimization solver.
+ *
+ * Copyright (c) 2024 by the authors listed in the file AUTHORS in the
+ * top-level source directory and their institutional affiliations. All rights
+ * reserved. See the file LICENSE.md in the top-level source directory for
+ * licensing information.
+ * ****************************************************************************
+ *
+ * Large neighborhood search with exact windows.
+ */
+
+#ifdef USE_LPSOLVE
+
+#include "large_neighborhood_search.h"
+#include "crossing_matrix.h"
+#include "environment.h"
+#include "ip_solver_lpsolve.h"
+
+#include <algorithm>
+#include <iostream>
+
+namespace banana {
+namespace solver {
+namespace heuristic {
+namespace lns {
+
+const int WINDOW = 32;
+const int STRIDE = WINDOW / 2;
+
+LargeNeighborhoodSearch::LargeNeighborhoodSearch(graph::BipartiteGraph graph)
+    : ImprovementRoutine(graph), m_random(Environment::seed())
+{}
+
+long long
+LargeNeighborhoodSearch::windowCrossings(const std::vector<int> &order,
+                                         int begin, int end) const
+{
+  long long crossings = 0;
+  for (int i = begin; i < end; i++)
+  {
+    for (int j = i + 1; j < end; j++)
+    {
+      crossings += crossing::CrossingMatrix::pairCrossings(
+                       m_neighbors[order[i] - m_offset],
+                       m_neighbors[order[j] - m_offset])
+                       .first;
+    }
+  }
+  return crossings;
+}
+
+uint64_t LargeNeighborhoodSearch::windowHash(const std::vector<int> &order,
+                                            int begin, int end)
+{
+  uint64_t hash = end - begin;
+  for (int i = begin; i < end; i++)
+  {
+    hash = (hash ^ (uint64_t)order[i]) * 0x100000001b3ull;
+    hash ^= hash >> 29;
+  }
+  return hash;
+}
+
+long long LargeNeighborhoodSearch::optimize(std::vector<int> &order,
+                                            int begin, int end)
+{
+  if (m_optimal.count(windowHash(order, begin, end)))
+    return 0;
+  long long before = windowCrossings(order, begin, end);
+  if (before == 0)
+    return 0;
+
+  /** Neighbors of the window, renumbered in the same order */
+  std::vector<int> column;
+  for (int i = begin; i < end; i++)
+  {
+    const auto &neighbors = m_neighbors[order[i] - m_offset];
+    column.insert(column.end(), neighbors.begin(), neighbors.end());
+  }
+  std::sort(column.begin(), column.end());
+  column.erase(std::unique(column.begin(), column.end()), column.end());
+  if (column.empty())
+    return 0;
+
+  /** B is numbered in the current order, so free pairs keep it */
+  int n_a = column.size(), size = end - begin;
+  graph::BipartiteGraph window(n_a, size);
+  for (int i = begin; i < end; i++)
+  {
+    for (int a : m_neighbors[order[i] - m_offset])
+    {
+      int index = std::lower_bound(column.begin(), column.end(), a) -
+                  column.begin();
+      window.addEdge(index, n_a + i - begin);
+    }
+  }
+
+  ip::LPSolveSolver solver(window);
+  solver.setIncumbent(nullptr);
+  solver.setSubproblem(window.getB());
+  solver.shorter();
+  std::vector<int> local;
+  solver.explain(local);
+
+  std::vector<int> candidate(size);
+  for (int i = 0; i < size; i++)
+  {
+    candidate[i] = order[begin + local[i] - n_a];
+  }
+  std::vector<int> current(order.begin() + begin, order.begin() + end);
+  std::copy(candidate.begin(), candidate.end(), order.begin() + begin);
+  long long after = windowCrossings(order, begin, end);
+  if (after >= before)
+    std::copy(current.begin(), current.end(), order.begin() + begin);
+  if (solver.provenOptimal())
+    m_optimal.insert(windowHash(order, begin, end));
+  return std::min(after - before, 0ll);
+}
+
+long long LargeNeighborhoodSearch::improve(std::vector<int> &order,
+                                           long long crossings)
+{
+  int n = order.size();
+  if (n < 2)
+    return crossings;
+
+  const utils::Deadline &deadline = Environment::deadline();
+  int windows = 0;
+  try
+  {
+    int offset = m_random() % STRIDE;
+    for (int start = -offset; start + 1 < n && !deadline.expired();
+         start += STRIDE)
+    {
+      int begin = std::max(start, 0), end = std::min(start + WINDOW, n);
+      if (end - begin < 2)
+        continue;
+      long long delta = optimize(order, begin, end);
+      windows++;
+      if (delta < 0)
+      {
+        crossings += delta;
+        publish(order, crossings);
+      }
+    }
+  }
+  catch (const utils::TimeLimitExceeded &)
+  {
+    /** The window being solved is dropped, and the order is still valid */
+  }
+  std::cerr << "lns: " << windows << " windows, crossings " << crossings
+            << std::endl;
+  return crossings;
+}
+
+} // namespace lns
+} // namespace heuristic
+} // namespace solver
+} // namespace banana
+
+#endif // USE_LPSOLVE
@@ -0,0 +1,80 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   Alan Prado
+ *
+ * This file is part of Banana, a one-sided crossing minimization solver.
+ *
+ * Copyright (c) 2024 by the authors listed in the file AUTHORS in the
+ * top-level source directory and their institutional affiliations. All rights
+ * reserved. See the file LICENSE.md in the top-level source directory for
+ * licensing information.
+ * ****************************************************************************
+ *
+ * Large neighborhood search with exact windows.
+ */
+
+#ifndef __PACE2024__LARGE_NEIGHBORHOOD_SEARCH_H
+#define __PACE2024__LARGE_NEIGHBORHOOD_SEARCH_H
+
+#include "improvement_routine.h"
+
+#include <cstdint>
+#include <random>
+#include <unordered_set>
+#include <vector>
+
+namespace banana {
+namespace solver {
+namespace heuristic {
+namespace lns {
+
+/**
+ * Large neighborhood search
+ *
+ * Re-optimizes windows of WINDOW consecutive vertices of the order, with
+ * everything outside them fixed. Vertices to the left of a window stay to
+ * its left whatever its order, so the crossings against them are the same
+ * for every order of the window, and the window alone is an instance of
+ * the problem: the subgraph induced by its vertices and their neighbors.
+ * It is solved exactly with the shorter lp_solve model, and spliced back
+ * when it has fewer crossings than the current order of the window.
+ *
+ * Each call makes one pass over the order, with windows that overlap by
+ * half and are shifted by a random offset, so that it takes a bounded share
+ * of the time and later calls cut the order elsewhere. Windows without
+ * crossings are skipped, the current order of a window is the upper bound
+ * of its program, and windows proven optimal are remembered, so later
+ * calls only solve the parts of the order that changed.
+ */
+class LargeNeighborhoodSearch : public ImprovementRoutine
+{
+public:
+  LargeNeighborhoodSearch(graph::BipartiteGraph graph);
+  ~LargeNeighborhoodSearch() override = default;
+  using ImprovementRoutine::improve;
+  long long improve(std::vector<int> &order, long long crossings) override;
+
+protected:
+  /** Crossings among the vertices of order[begin, end) */
+  long long windowCrossings(const std::vector<int> &order, int begin,
+                            int end) const;
+  /**
+   * Solves the window order[begin, end) exactly and stores it there if it
+   * is better. Returns the change in crossings.
+   */
+  long long optimize(std::vector<int> &order, int begin, int end);
+  /** Hash of the sequence order[begin, end) */
+  static uint64_t windowHash(const std::vector<int> &order, int begin,
+                             int end);
+
+  std::mt19937_64 m_random;
+  /** Windows whose order is known to be optimal */
+  std::unordered_set<uint64_t> m_optimal;
+};
+
+} // namespace lns
+} // namespace heuristic
+} // namespace solver
+} // namespace banana
+
+#endif // __PACE2024__LARGE_NEIGHBORHOOD_SEARCH_H
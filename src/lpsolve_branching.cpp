@@ -0,0 +1,103 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   Alan Prado
+ *
+ * This file is part of Banana, a one-sided crossing minimization solver.
+ *
+ * Copyright (c) 2024 by the authors listed in the file AUTHORS in the
+ * top-level source directory and their institutional affiliations. All rights
+ * reserved. See the file LICENSE.md in the top-level source directory for
+ * licensing information.
+ * ****************************************************************************
+ *
+ * Problem-aware branching for the LPSolve solver.
+ */
+
+#ifdef USE_LPSOLVE
+
+#include "lpsolve_branching.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace banana {
+namespace solver {
+namespace ip {
+
+LPSolveBranching::LPSolveBranching(options::IPBranching strategy,
+                                   std::vector<double> costs,
+                                   std::vector<char> preferred)
+    : m_strategy(strategy), m_costs(std::move(costs)),
+      m_preferred(std::move(preferred))
+{}
+
+void LPSolveBranching::attach(lprec *lp)
+{
+  switch (m_strategy)
+  {
+  case options::IPBranching::PRIORITY:
+  {
+    /** lp_solve sorts the weights increasingly: smaller goes first */
+    std::vector<double> weights(m_costs.size() - 1);
+    for (int j = 1; j < (int)m_costs.size(); j++)
+    {
+      weights[j - 1] = -std::abs(m_costs[j]);
+    }
+    set_var_weights(lp, weights.data());
+    put_bb_branchfunc(lp, selectBranch, this);
+    break;
+  }
+  case options::IPBranching::SCORE:
+    put_bb_nodefunc(lp, selectNode, this);
+    put_bb_branchfunc(lp, selectBranch, this);
+    break;
+  default:
+    break;
+  }
+}
+
+int __WINAPI LPSolveBranching::selectNode(lprec *lp, void *handle,
+                                          int vartype)
+{
+  if (vartype != BB_INT)
+    return -1;
+
+  const LPSolveBranching *branching =
+      static_cast<const LPSolveBranching *>(handle);
+  double epsilon = get_epsint(lp);
+  int best = 0;
+  double best_score = -1;
+  for (int j = 1; j <= lp->columns; j++)
+  {
+    /** Solution of the current node; rows come first */
+    double value = lp->solution[lp->rows + j];
+    double fraction = std::min(value - std::floor(value),
+                               std::ceil(value) - value);
+    if (fraction <= epsilon)
+      continue;
+    double score = std::abs(branching->m_costs[j]) * fraction;
+    if (score > best_score)
+    {
+      best_score = score;
+      best = j;
+    }
+  }
+
+  /** 0 tells lp_solve that every column is integral */
+  return best == 0 ? 0 : lp->rows + best;
+}
+
+int __WINAPI LPSolveBranching::selectBranch(lprec *lp, void *handle,
+                                            int column)
+{
+  const LPSolveBranching *branching =
+      static_cast<const LPSolveBranching *>(handle);
+  /** TRUE explores the floor (x_j = 0) first */
+  return branching->m_preferred[column] ? FALSE : TRUE;
+}
+
+} // namespace ip
+} // namespace solver
+} // namespace banana
+
+#endif // USE_LPSOLVE
@@ -0,0 +1,70 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   Alan Prado
+ *
+ * This file is part of Banana, a one-sided crossing minimization solver.
+ *
+ * Copyright (c) 2024 by the authors listed in the file AUTHORS in the
+ * top-level source directory and their institutional affiliations. All rights
+ * reserved. See the file LICENSE.md in the top-level source directory for
+ * licensing information.
+ * ****************************************************************************
+ *
+ * Problem-aware branching for the LPSolve solver.
+ */
+
+#ifndef __PACE2024__LPSOLVE_BRANCHING_H
+#define __PACE2024__LPSOLVE_BRANCHING_H
+
+#include "options.h"
+#include "../lp_solve_5.5/lp_lib.h"
+
+#include <vector>
+
+namespace banana {
+namespace solver {
+namespace ip {
+
+/**
+ * Branching strategy for the 0-1 columns of an lp_solve model
+ *
+ * Each column x_j has a cost |c_j| (what is lost by orienting the pair
+ * against its cheaper side) and a preferred value, its orientation in the
+ * heuristic order. Depending on the strategy:
+ *
+ *   PRIORITY: columns with larger cost get higher priority, through
+ *             set_var_weights; lp_solve branches on the first fractional one.
+ *   SCORE:    the node callback picks the fractional column maximizing
+ *             |c_j| \cdot min(x_j, 1 - x_j).
+ *
+ * In both, the branch callback explores the preferred value first.
+ */
+class LPSolveBranching
+{
+public:
+  /**
+   * 'costs' and 'preferred' are indexed by column, starting at 1 as in
+   * lp_solve (element 0 is ignored).
+   */
+  LPSolveBranching(options::IPBranching strategy, std::vector<double> costs,
+                   std::vector<char> preferred);
+  ~LPSolveBranching() = default;
+
+  /** Installs the strategy on 'lp'. The object must outlive the solve. */
+  void attach(lprec *lp);
+
+protected:
+  /** lp_solve callbacks, with this object as user handle */
+  static int __WINAPI selectNode(lprec *lp, void *handle, int vartype);
+  static int __WINAPI selectBranch(lprec *lp, void *handle, int column);
+
+  options::IPBranching m_strategy;
+  std::vector<double> m_costs;
+  std::vector<char> m_preferred;
+};
+
+} // namespace ip
+} // namespace solver
+} // namespace banana
+
+#endif // __PACE2024__LPSOLVE_BRANCHING_H
@@ -0,0 +1,110 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   Alan Prado
+ *
+ * This file is part of Banana, a one-sided crossing minimization solver.
+ *
+ * Copyright (c) 2024 by the authors listed in the file AUTHORS in the
+ * top-level source directory and their institutional affiliations. All rights
+ * reserved. See the file LICENSE.md in the top-level source directory for
+ * licensing information.
+ * ****************************************************************************
+ *
+ * Rounding of the LP relaxations solved by lp_solve.
+ */
+
+#ifdef USE_LPSOLVE
+
+#include "lpsolve_rounding.h"
+#include "crossing_matrix.h"
+#include "environment.h"
+
+#include <algorithm>
+#include <iostream>
+
+namespace banana {
+namespace solver {
+namespace ip {
+
+/** Nodes of the branch and bound between two roundings */
+const int ROUNDING_PERIOD = 64;
+
+LPSolveRounding::LPSolveRounding(
+    const graph::BipartiteGraph &graph,
+    const std::vector<std::pair<int, int>> &pairs,
+    long long objective_offset, Incumbent *incumbent)
+    : m_offset(graph.countVerticesA()), m_pairs(pairs),
+      m_objectiveOffset(objective_offset), m_incumbent(incumbent),
+      m_sifting(graph)
+{
+  crossing::OrientablePairs orientable(graph, pairs);
+  int n = graph.countVerticesB();
+  m_forced.assign(n, 0);
+  for (int i = 0; i < n; i++)
+  {
+    for (int j = 0; j < n; j++)
+    {
+      if (i != j && orientable.forcedBefore(i + m_offset, j + m_offset))
+        m_forced[i]++;
+    }
+  }
+}
+
+void LPSolveRounding::attach(lprec *lp)
+{
+  m_next = lp->bb_usenode;
+  m_nextHandle = lp->bb_nodehandle;
+  put_bb_nodefunc(lp, selectNode, this);
+}
+
+void LPSolveRounding::round(lprec *lp)
+{
+  std::vector<double> successors(m_forced.begin(), m_forced.end());
+  for (int p = 0; p < (int)m_pairs.size(); p++)
+  {
+    /** Solution of the current node; rows come first */
+    double x = lp->solution[lp->rows + p + 1];
+    auto [i, j] = m_pairs[p];
+    successors[i - m_offset] += x;
+    successors[j - m_offset] += 1 - x;
+  }
+
+  std::vector<int> order(successors.size());
+  for (int v = 0; v < (int)order.size(); v++)
+  {
+    order[v] = v + m_offset;
+  }
+  std::stable_sort(order.begin(), order.end(), [&](int u, int v) {
+    return successors[u - m_offset] > successors[v - m_offset];
+  });
+  long long crossings = m_sifting.improve(order);
+  if (m_crossings != -1 && crossings >= m_crossings)
+    return;
+
+  m_order = order, m_crossings = crossings;
+  if (m_incumbent != nullptr)
+    m_incumbent->offer(order, crossings);
+  set_obj_bound(lp, crossings - m_objectiveOffset);
+  std::cerr << "rounding: " << crossings << " at node " << m_nodes - 1
+            << std::endl;
+}
+
+int __WINAPI LPSolveRounding::selectNode(lprec *lp, void *handle,
+                                         int vartype)
+{
+  LPSolveRounding *rounding = static_cast<LPSolveRounding *>(handle);
+  if (vartype == BB_INT && rounding->m_nodes++ % ROUNDING_PERIOD == 0 &&
+      !Environment::deadline().expired())
+  {
+    rounding->round(lp);
+  }
+  if (rounding->m_next == nullptr)
+    return -1; // lp_solve picks the column
+  return rounding->m_next(lp, rounding->m_nextHandle, vartype);
+}
+
+} // namespace ip
+} // namespace solver
+} // namespace banana
+
+#endif // USE_LPSOLVE
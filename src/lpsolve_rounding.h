@@ -0,0 +1,94 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   Alan Prado
+ *
+ * This file is part of Banana, a one-sided crossing minimization solver.
+ *
+ * Copyright (c) 2024 by the authors listed in the file AUTHORS in the
+ * top-level source directory and their institutional affiliations. All rights
+ * reserved. See the file LICENSE.md in the top-level source directory for
+ * licensing information.
+ * ****************************************************************************
+ *
+ * Rounding of the LP relaxations solved by lp_solve.
+ */
+
+#ifndef __PACE2024__LPSOLVE_ROUNDING_H
+#define __PACE2024__LPSOLVE_ROUNDING_H
+
+#include "bipartite_graph.h"
+#include "incumbent.h"
+#include "sifting.h"
+#include "../lp_solve_5.5/lp_lib.h"
+
+#include <utility>
+#include <vector>
+
+namespace banana {
+namespace solver {
+namespace ip {
+
+/**
+ * LP rounding heuristic for the shorter formulation
+ *
+ * Turns the fractional solution x of a node of the branch and bound into an
+ * order: each vertex i gets the fractional number of successors
+ *
+ *   \sum_{j > i} x_{i,j} + \sum_{j < i} (1 - x_{j,i}),
+ *
+ * plus its forced successors among the pairs that are not orientable, and
+ * the vertices are sorted by it, as shorter() does with integral solutions.
+ * The order is refined with sifting. Better orders are offered to the
+ * incumbent and become the objective bound of lp_solve (set_obj_bound),
+ * which prunes nodes until it finds a solution of its own.
+ *
+ * Runs from the node callback: at the root, and then every ROUNDING_PERIOD
+ * nodes. A node function installed before (see lpsolve_branching.h) is
+ * still called to select the branching column.
+ */
+class LPSolveRounding
+{
+public:
+  /**
+   * 'pairs' are the orientable pairs (i, j), i < j, in column order, and
+   * 'objective_offset' the constant of the objective.
+   */
+  LPSolveRounding(const graph::BipartiteGraph &graph,
+                  const std::vector<std::pair<int, int>> &pairs,
+                  long long objective_offset, Incumbent *incumbent);
+  ~LPSolveRounding() = default;
+
+  /** Installs the callback on 'lp'. The object must outlive the solve. */
+  void attach(lprec *lp);
+
+  /** Best rounded order and its crossings, or -1 if there is none */
+  const std::vector<int> &order() const { return m_order; }
+  long long crossings() const { return m_crossings; }
+
+protected:
+  /** lp_solve node callback, with this object as user handle */
+  static int __WINAPI selectNode(lprec *lp, void *handle, int vartype);
+  /** Rounds the solution of the current node of 'lp' */
+  void round(lprec *lp);
+
+  int m_offset;
+  std::vector<std::pair<int, int>> m_pairs;
+  /** Forced successors of each vertex of B */
+  std::vector<int> m_forced;
+  long long m_objectiveOffset;
+  Incumbent *m_incumbent;
+  heuristic::sifting::Sifting m_sifting;
+
+  int m_nodes = 0;
+  lphandleint_intfunc *m_next = nullptr;
+  void *m_nextHandle = nullptr;
+
+  std::vector<int> m_order;
+  long long m_crossings = -1;
+};
+
+} // namespace ip
+} // namespace solver
+} // namespace banana
+
+#endif // __PACE2024__LPSOLVE_ROUNDING_H
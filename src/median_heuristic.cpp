@@ -14,6 +14,8 @@
  */
 
 #include "median_heuristic.h"
+#include "tie_resolution.h"
+
 #include <algorithm>
 
 namespace banana {
@@ -36,7 +38,7 @@ int MedianHeuristic::median(std::vector<int> &neighbors)
   return neighbors[neighbors.size() / 2];
 }
 
-int MedianHeuristic::solve()
+long long MedianHeuristic::solve()
 {
   int n0 = m_graph.countVerticesA();
   int n1 = m_graph.countVerticesB();
@@ -50,15 +52,20 @@ int MedianHeuristic::solve()
   }
 
   std::vector<int> b_layer;
+  std::vector<long long> key;
   for (int i = 0; i < n0; i++)
   {
     for (int j = 0; j < med_layer[i].size(); j++)
     {
       b_layer.push_back(med_layer[i][j]);
+      key.push_back(i);
     }
   }
+  /** Vertices sharing a median are in no particular order */
+  ties::TieResolution(m_graph).resolve(b_layer, key);
 
-  return numberOfCrossings(b_layer);
+  m_order = b_layer;
+  return numberOfCrossings(m_order);
 }
 
 } // namespace median
@@ -43,7 +43,7 @@ class MedianHeuristic : public ApproximationRoutine
 public:
   MedianHeuristic(graph::BipartiteGraph graph);
   ~MedianHeuristic() override = default;
-  int solve() override;
+  long long solve() override;
 
 private:
   int median(std::vector<int> &neighbors);
@@ -0,0 +1,298 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   Alan Prado
+ *
+ * This file is part of Banana, a one-sided crossing minimization solver.
+ *
+ * Copyright (c) 2024 by the authors listed in the file AUTHORS in the
+ * top-level source directory and their institutional affiliations. All rights
+ * reserved. See the file LICENSE.md in the top-level source directory for
+ * licensing information.
+ * ****************************************************************************
+ *
+ * Memetic algorithm over orders of B.
+ */
+
+#include "memetic_algorithm.h"
+#include "barycenter_heuristic.h"
+#include "environment.h"
+#include "fenwick_tree.h"
+#include "greedy_switch.h"
+#include "median_heuristic.h"
+#include "sifting.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+
+namespace banana {
+namespace solver {
+namespace heuristic {
+namespace memetic {
+
+const int POPULATION = 16;
+const int STALL_GENERATIONS = 20;
+/** Mean disagreement per vertex below which the population is diversified */
+const double MIN_DIVERSITY = 0.25;
+/** Perturbations that make an individual out of another */
+const int MUTATIONS = 4;
+
+MemeticAlgorithm::MemeticAlgorithm(
+    graph::BipartiteGraph graph,
+    std::shared_ptr<const crossing::DenseCrossingMatrix> matrix)
+    : ImprovementRoutine(graph), m_matrix(matrix),
+      m_random(Environment::seed()), m_populationSize(POPULATION)
+{
+  if (m_matrix == nullptr && crossing::DenseCrossingMatrix::fits(graph))
+    m_matrix = std::make_shared<crossing::DenseCrossingMatrix>(graph);
+}
+
+void MemeticAlgorithm::setPopulation(int population)
+{
+  m_populationSize = std::max(population, 2);
+}
+
+void MemeticAlgorithm::setSeed(unsigned long long seed)
+{
+  m_random.seed(seed);
+}
+
+void MemeticAlgorithm::setDeadline(const utils::Deadline &deadline)
+{
+  m_deadline = deadline;
+}
+
+bool MemeticAlgorithm::expired() const
+{
+  return m_deadline.expired() || Environment::deadline().expired();
+}
+
+long long MemeticAlgorithm::disagreement(const std::vector<int> &a,
+                                         const std::vector<int> &b) const
+{
+  int n = a.size();
+  std::vector<int> position(n);
+  for (int i = 0; i < n; i++)
+  {
+    position[b[i] - m_offset] = i;
+  }
+
+  /** Inversions of the positions in 'b', taken in the order of 'a' */
+  long long inversions = 0;
+  library::FenwickTree<int> tree(n);
+  for (int v : a)
+  {
+    int p = position[v - m_offset];
+    inversions += tree.suffixQuery(p + 1);
+    tree.update(p, +1);
+  }
+  return inversions;
+}
+
+std::vector<int> MemeticAlgorithm::crossover(const std::vector<int> &a,
+                                             const std::vector<int> &b)
+{
+  int n = a.size();
+  std::vector<int> position(n);
+  for (int i = 0; i < n; i++)
+  {
+    position[b[i] - m_offset] = i;
+  }
+
+  double lambda = std::uniform_real_distribution<double>(0, 1)(m_random);
+  std::vector<std::pair<double, int>> keys(n);
+  for (int i = 0; i < n; i++)
+  {
+    keys[i] = {lambda * i + (1 - lambda) * position[a[i] - m_offset], i};
+  }
+  std::sort(keys.begin(), keys.end());
+
+  std::vector<int> child(n);
+  for (int k = 0; k < n; k++)
+  {
+    child[k] = a[keys[k].second];
+  }
+  return child;
+}
+
+void MemeticAlgorithm::evaluate(std::vector<Individual> &batch) const
+{
+  library::ThreadPool::global().parallelFor(
+      0, batch.size(),
+      [&](int i) {
+        auto &[order, crossings] = batch[i];
+        crossings = numberOfCrossings(order);
+
+        std::vector<std::unique_ptr<ImprovementRoutine>> searches;
+        if (m_matrix != nullptr)
+        {
+          searches.push_back(
+              std::make_unique<exchange::GreedySwitch>(m_graph, m_matrix));
+        }
+        searches.push_back(std::make_unique<sifting::Sifting>(m_graph));
+
+        bool improved = true;
+        while (improved && !expired())
+        {
+          improved = false;
+          for (auto &search : searches)
+          {
+            search->setIncumbent(m_incumbent);
+            long long result = search->improve(order, crossings);
+            if (result < crossings)
+              crossings = result, improved = true;
+          }
+        }
+      },
+      1);
+}
+
+double MemeticAlgorithm::diversity() const
+{
+  int size = m_population.size();
+  std::vector<std::pair<int, int>> pairs;
+  for (int i = 0; i < size; i++)
+  {
+    for (int j = i + 1; j < size; j++)
+    {
+      pairs.push_back({i, j});
+    }
+  }
+  if (pairs.empty())
+    return 0;
+
+  std::vector<long long> distances(pairs.size());
+  library::ThreadPool::global().parallelFor(
+      0, pairs.size(),
+      [&](int p) {
+        auto [i, j] = pairs[p];
+        distances[p] =
+            disagreement(m_population[i].first, m_population[j].first);
+      },
+      1);
+
+  double total = 0;
+  for (long long d : distances)
+  {
+    total += d;
+  }
+  return total / pairs.size();
+}
+
+int MemeticAlgorithm::tournament()
+{
+  int i = m_random() % m_population.size();
+  int j = m_random() % m_population.size();
+  return m_population[i].second <= m_population[j].second ? i : j;
+}
+
+const MemeticAlgorithm::Individual &MemeticAlgorithm::evolve()
+{
+  auto by_crossings = [](const Individual &x, const Individual &y) {
+    return x.second < y.second;
+  };
+  int n = m_graph.countVerticesB();
+  int size = m_population.size();
+
+  for (int stall = 0; stall < STALL_GENERATIONS && !expired();)
+  {
+    std::vector<Individual> children;
+    for (int c = 0; c < size; c++)
+    {
+      int i = tournament(), j = tournament();
+      children.push_back(
+          {crossover(m_population[i].first, m_population[j].first), 0});
+    }
+    evaluate(children);
+
+    long long best = std::min_element(m_population.begin(),
+                                      m_population.end(), by_crossings)
+                         ->second;
+    for (Individual &child : children)
+    {
+      auto worst = std::max_element(m_population.begin(), m_population.end(),
+                                    by_crossings);
+      bool duplicate = std::any_of(
+          m_population.begin(), m_population.end(),
+          [&](const Individual &x) { return x.first == child.first; });
+      if (child.second < worst->second && !duplicate)
+        *worst = std::move(child);
+    }
+    long long next = std::min_element(m_population.begin(),
+                                      m_population.end(), by_crossings)
+                         ->second;
+    stall = next < best ? 0 : stall + 1;
+
+    double d = diversity();
+    if (d < MIN_DIVERSITY * n && !expired())
+    {
+      /** Keeps the best individual, and moves the others away from it */
+      std::sort(m_population.begin(), m_population.end(), by_crossings);
+      std::vector<Individual> mutants(m_population.begin() + 1,
+                                      m_population.end());
+      for (auto &[order, crossings] : mutants)
+      {
+        for (int k = 0; k < MUTATIONS; k++)
+        {
+          perturb(order, m_random, m_matrix.get());
+        }
+      }
+      evaluate(mutants);
+      std::move(mutants.begin(), mutants.end(), m_population.begin() + 1);
+    }
+  }
+  return *std::min_element(m_population.begin(), m_population.end(),
+                           by_crossings);
+}
+
+long long MemeticAlgorithm::improve(std::vector<int> &order,
+                                    long long crossings)
+{
+  if (order.size() < 2 || expired())
+    return crossings;
+
+  /** The given order, the constructive orders, and mutants of the first */
+  std::vector<Individual> initial;
+  barycenter::BarycenterHeuristic barycenter(m_graph);
+  median::MedianHeuristic median(m_graph);
+  for (ApproximationRoutine *h :
+       std::vector<ApproximationRoutine *>{&barycenter, &median})
+  {
+    h->solve();
+    std::vector<int> start;
+    h->explain(start);
+    initial.push_back({start, 0});
+  }
+  while ((int)initial.size() + 1 < m_populationSize)
+  {
+    std::vector<int> mutant = order;
+    for (int k = 0; k < MUTATIONS; k++)
+    {
+      perturb(mutant, m_random, m_matrix.get());
+    }
+    initial.push_back({mutant, 0});
+  }
+  evaluate(initial);
+
+  m_population = {{order, crossings}};
+  m_population.insert(m_population.end(), initial.begin(), initial.end());
+  const Individual &best = evolve();
+  if (best.second < crossings)
+    order = best.first, crossings = best.second;
+  m_order = order;
+  return crossings;
+}
+
+long long MemeticAlgorithm::solve()
+{
+  barycenter::BarycenterHeuristic barycenter(m_graph);
+  barycenter.solve();
+  std::vector<int> order;
+  barycenter.explain(order);
+  long long crossings = numberOfCrossings(order);
+  return improve(order, crossings);
+}
+
+} // namespace memetic
+} // namespace heuristic
+} // namespace solver
+} // namespace banana
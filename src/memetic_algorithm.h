@@ -0,0 +1,100 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   Alan Prado
+ *
+ * This file is part of Banana, a one-sided crossing minimization solver.
+ *
+ * Copyright (c) 2024 by the authors listed in the file AUTHORS in the
+ * top-level source directory and their institutional affiliations. All rights
+ * reserved. See the file LICENSE.md in the top-level source directory for
+ * licensing information.
+ * ****************************************************************************
+ *
+ * Memetic algorithm over orders of B.
+ */
+
+#ifndef __PACE2024__MEMETIC_ALGORITHM_H
+#define __PACE2024__MEMETIC_ALGORITHM_H
+
+#include "deadline.h"
+#include "dense_crossing_matrix.h"
+#include "improvement_routine.h"
+
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace banana {
+namespace solver {
+namespace heuristic {
+namespace memetic {
+
+/**
+ * Memetic algorithm
+ *
+ * Keeps a population of locally optimal orders. Each generation breeds as
+ * many children as there are individuals, from parents chosen by binary
+ * tournaments. The crossover sorts the vertices by a random convex
+ * combination of their positions in both parents: if u is before v in both,
+ * it is before v in the child, so every relative order the parents agree on
+ * is kept, and the others are taken mostly from one parent. Children are
+ * improved by local search and counted in one batch on the thread pool.
+ *
+ * A child replaces the worst individual if it is better and not already in
+ * the population. The diversity of the population is the mean number of
+ * pairs that two individuals orient differently (the Kendall tau distance);
+ * when it falls below MIN_DIVERSITY per vertex, every individual but the
+ * best is perturbed and improved again. The search stops after
+ * STALL_GENERATIONS generations without a new best, or when the deadline
+ * (Environment::deadline() or the one given) expires.
+ */
+class MemeticAlgorithm : public ImprovementRoutine
+{
+public:
+  MemeticAlgorithm(
+      graph::BipartiteGraph graph,
+      std::shared_ptr<const crossing::DenseCrossingMatrix> matrix = nullptr);
+  ~MemeticAlgorithm() override = default;
+  long long solve() override;
+  using ImprovementRoutine::improve;
+  long long improve(std::vector<int> &order, long long crossings) override;
+
+  void setPopulation(int population);
+  void setSeed(unsigned long long seed);
+  /** Stops at this deadline too, if it comes before the global one */
+  void setDeadline(const utils::Deadline &deadline);
+
+  /** Number of pairs of vertices that 'a' and 'b' orient differently */
+  long long disagreement(const std::vector<int> &a,
+                         const std::vector<int> &b) const;
+
+protected:
+  using Individual = std::pair<std::vector<int>, long long>;
+
+  bool expired() const;
+  /** Child of 'a' and 'b' that keeps the relative orders they agree on */
+  std::vector<int> crossover(const std::vector<int> &a,
+                             const std::vector<int> &b);
+  /** Counts and improves every order of 'batch' on the thread pool */
+  void evaluate(std::vector<Individual> &batch) const;
+  /** Mean disagreement between the individuals of the population */
+  double diversity() const;
+  int tournament();
+  /** Evolves m_population; returns the best individual */
+  const Individual &evolve();
+
+  std::shared_ptr<const crossing::DenseCrossingMatrix> m_matrix;
+  std::mt19937_64 m_random;
+  int m_populationSize;
+  utils::Deadline m_deadline;
+
+  std::vector<Individual> m_population;
+};
+
+} // namespace memetic
+} // namespace heuristic
+} // namespace solver
+} // namespace banana
+
+#endif // __PACE2024__MEMETIC_ALGORITHM_H
@@ -0,0 +1,96 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   Alan Prado
+ *
+ * This file is part of Banana, a one-sided crossing minimization solver.
+ *
+ * Copyright (c) 2024 by the authors listed in the file AUTHORS in the
+ * top-level source directory and their institutional affiliations. All rights
+ * reserved. See the file LICENSE.md in the top-level source directory for
+ * licensing information.
+ * ****************************************************************************
+ *
+ * Merge sort with crossing numbers as the comparator.
+ */
+
+#include "merge_sort_heuristic.h"
+#include "barycenter_heuristic.h"
+#include "crossing_matrix.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+
+namespace banana {
+namespace solver {
+namespace heuristic {
+namespace mergesort {
+
+/** Ranges below this size are sorted by the calling thread alone */
+const int SEQUENTIAL_CUTOFF = 4096;
+
+MergeSortHeuristic::MergeSortHeuristic(graph::BipartiteGraph graph)
+    : ApproximationRoutine(graph), m_offset(graph.countVerticesA()),
+      m_neighbors(crossing::CrossingMatrix::sortedNeighborhoods(graph))
+{
+}
+
+bool MergeSortHeuristic::before(int v, int u) const
+{
+  auto [vu, uv] = crossing::CrossingMatrix::pairCrossings(
+      m_neighbors[v - m_offset], m_neighbors[u - m_offset]);
+  return vu < uv;
+}
+
+void MergeSortHeuristic::sort(int begin, int end, std::vector<int> &buffer)
+{
+  if (end - begin < 2)
+    return;
+
+  int middle = begin + (end - begin) / 2;
+  if (end - begin < SEQUENTIAL_CUTOFF)
+  {
+    sort(begin, middle, buffer);
+    sort(middle, end, buffer);
+  }
+  else
+  {
+    /** The halves use disjoint ranges of 'buffer' */
+    library::ThreadPool::global().parallelFor(0, 2, [&](int s) {
+      if (s == 0)
+        sort(begin, middle, buffer);
+      else
+        sort(middle, end, buffer);
+    });
+  }
+
+  int i = begin, j = middle, k = begin;
+  while (i < middle && j < end)
+  {
+    if (before(m_order[j], m_order[i]))
+      buffer[k++] = m_order[j++];
+    else
+      buffer[k++] = m_order[i++];
+  }
+  std::copy(m_order.begin() + i, m_order.begin() + middle,
+            buffer.begin() + k);
+  std::copy(m_order.begin() + j, m_order.begin() + end,
+            buffer.begin() + k + (middle - i));
+  std::copy(buffer.begin() + begin, buffer.begin() + end,
+            m_order.begin() + begin);
+}
+
+long long MergeSortHeuristic::solve()
+{
+  barycenter::BarycenterHeuristic barycenter(m_graph);
+  barycenter.solve();
+  barycenter.explain(m_order);
+
+  std::vector<int> buffer(m_order.size());
+  sort(0, m_order.size(), buffer);
+  return numberOfCrossings(m_order);
+}
+
+} // namespace mergesort
+} // namespace heuristic
+} // namespace solver
+} // namespace banana
@@ -0,0 +1,62 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   Alan Prado
+ *
+ * This file is part of Banana, a one-sided crossing minimization solver.
+ *
+ * Copyright (c) 2024 by the authors listed in the file AUTHORS in the
+ * top-level source directory and their institutional affiliations. All rights
+ * reserved. See the file LICENSE.md in the top-level source directory for
+ * licensing information.
+ * ****************************************************************************
+ *
+ * Merge sort with crossing numbers as the comparator.
+ */
+
+#ifndef __PACE2024__MERGE_SORT_HEURISTIC_H
+#define __PACE2024__MERGE_SORT_HEURISTIC_H
+
+#include "approximation_routine.h"
+
+#include <vector>
+
+namespace banana {
+namespace solver {
+namespace heuristic {
+namespace mergesort {
+
+/**
+ * Majority merge sort
+ *
+ * Sorts the barycenter order with merge sort, where v from the right half is
+ * taken before u from the left half iff c_{v,u} < c_{u,v}, that is, iff the
+ * majority of the crossings of the pair favors it. Comparisons go to the
+ * next vertex of the left half on ties, so the sort is stable and the order
+ * only changes where it saves crossings. O(n log n) comparisons, each one
+ * merging two sorted neighborhoods, so no matrix is built. Both halves of
+ * large ranges are sorted in parallel.
+ */
+class MergeSortHeuristic : public ApproximationRoutine
+{
+public:
+  MergeSortHeuristic(graph::BipartiteGraph graph);
+  ~MergeSortHeuristic() override = default;
+  long long solve() override;
+
+protected:
+  /** Whether v goes strictly before u */
+  bool before(int v, int u) const;
+  /** Sorts m_order[begin, end), using 'buffer' for the merge */
+  void sort(int begin, int end, std::vector<int> &buffer);
+
+  int m_offset;
+  /** Sorted neighborhood of each vertex of B, indexed by vertex - m_offset */
+  std::vector<std::vector<int>> m_neighbors;
+};
+
+} // namespace mergesort
+} // namespace heuristic
+} // namespace solver
+} // namespace banana
+
+#endif // __PACE2024__MERGE_SORT_HEURISTIC_H
@@ -19,6 +19,7 @@
 
 #include "bipartite_graph.h"
 #include "fenwick_tree.h"
+#include "incumbent.h"
 
 #include <algorithm>
 #include <iostream>
@@ -37,17 +38,39 @@ public:
   MetaSolver(T G) : m_graph(G) {}
   virtual ~MetaSolver() {}
 
-  virtual int solve() = 0;
+  virtual long long solve() = 0;
   void explain(std::vector<U> &order);
-  bool verify(const std::vector<U> &order, int expected_crossings) const;
+  bool verify(const std::vector<U> &order,
+              long long expected_crossings) const;
+  /** Shares the orders found by this solver; nullptr keeps them private */
+  void setIncumbent(Incumbent *incumbent);
 
 protected:
-  int numberOfCrossings(const std::vector<U> &order) const;
+  long long numberOfCrossings(const std::vector<U> &order) const;
+  /** Offers 'order' to the incumbent, if there is one */
+  void publish(const std::vector<U> &order, long long crossings);
 
   T const m_graph;
   std::vector<U> m_order;
+  Incumbent *m_incumbent = nullptr;
 };
 
+template <class T, class U>
+void MetaSolver<T, U>::setIncumbent(Incumbent *incumbent)
+{
+  m_incumbent = incumbent;
+}
+
+template <class T, class U>
+void MetaSolver<T, U>::publish(const std::vector<U> &order,
+                                long long crossings)
+{
+  if (m_incumbent != nullptr)
+  {
+    m_incumbent->offer(order, crossings);
+  }
+}
+
 template <class T, class U>
 void MetaSolver<T, U>::explain(std::vector<U> &order)
 {
@@ -59,7 +82,8 @@ void MetaSolver<T, U>::explain(std::vector<U> &order)
 }
 
 template <class T, class U>
-int MetaSolver<T, U>::numberOfCrossings(const std::vector<U> &order) const
+long long
+MetaSolver<T, U>::numberOfCrossings(const std::vector<U> &order) const
 {
   int nA = m_graph.countVerticesA();
   int nB = m_graph.countVerticesB();
@@ -84,7 +108,7 @@ int MetaSolver<T, U>::numberOfCrossings(const std::vector<U> &order) const
     return position[b1 - nA] < position[b2 - nA];
   });
 
-  int crossings = 0;
+  long long crossings = 0;
   library::FenwickTree<int> tree(nA);
 
   for (int l = 0, r = 0; l < (int)edges.size(); l = r)
@@ -116,7 +140,7 @@ int MetaSolver<T, U>::numberOfCrossings(const std::vector<U> &order) const
 
 template <class T, class U>
 bool MetaSolver<T, U>::verify(const std::vector<U> &order,
-                              int expected_crossings) const
+                              long long expected_crossings) const
 {
   assert(order.size() == m_graph.countVerticesB());
   auto nc = numberOfCrossings(order);
@@ -0,0 +1,180 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   Alan Prado
+ *
+ * This file is part of Banana, a one-sided crossing minimization solver.
+ *
+ * Copyright (c) 2024 by the authors listed in the file AUTHORS in the
+ * top-level source directory and their institutional affiliations. All rights
+ * reserved. See the file LICENSE.md in the top-level source directory for
+ * licensing information.
+ * ****************************************************************************
+ *
+ * Multi-start parallel local search.
+ */
+
+#include "multi_start_search.h"
+#include "adjacent_exchange.h"
+#include "barycenter_heuristic.h"
+#include "environment.h"
+#include "greedy_switch.h"
+#include "insertion_heuristic.h"
+#include "median_heuristic.h"
+#include "sifting.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <cassert>
+#include <climits>
+#include <iostream>
+#include <sstream>
+
+namespace banana {
+namespace solver {
+namespace heuristic {
+namespace multistart {
+
+const int MIN_CHAINS = 4;
+
+MultiStartSearch::MultiStartSearch(
+    graph::BipartiteGraph graph,
+    std::shared_ptr<const crossing::DenseCrossingMatrix> matrix)
+    : ImprovementRoutine(graph), m_matrix(matrix),
+      m_chains(Environment::options().heuristic.chains), m_runs(0)
+{
+  if (m_matrix == nullptr && crossing::DenseCrossingMatrix::fits(graph))
+    m_matrix = std::make_shared<crossing::DenseCrossingMatrix>(graph);
+}
+
+void MultiStartSearch::setChains(int chains) { m_chains = chains; }
+
+int MultiStartSearch::chains() const
+{
+  if (m_chains > 0)
+    return m_chains;
+  return std::max<int>(MIN_CHAINS, library::ThreadPool::global().size());
+}
+
+unsigned long long MultiStartSearch::chainSeed(int c)
+{
+  /** splitmix64, so that nearby chains get unrelated streams */
+  unsigned long long z = Environment::seed() + (c + 1) * 0x9e3779b97f4a7c15ull;
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+  return z ^ (z >> 31);
+}
+
+long long MultiStartSearch::descend(std::vector<int> &order,
+                                    long long crossings) const
+{
+  std::vector<std::unique_ptr<ImprovementRoutine>> searches;
+  if (m_matrix != nullptr)
+  {
+    searches.push_back(
+        std::make_unique<exchange::GreedySwitch>(m_graph, m_matrix));
+    searches.push_back(std::make_unique<sifting::Sifting>(m_graph));
+  }
+  else
+  {
+    searches.push_back(std::make_unique<exchange::AdjacentExchange>(m_graph));
+    searches.push_back(
+        std::make_unique<insertion::InsertionHeuristic>(m_graph));
+  }
+
+  const utils::Deadline &deadline = Environment::deadline();
+  bool improved = true;
+  while (improved && !deadline.expired())
+  {
+    improved = false;
+    for (auto &search : searches)
+    {
+      search->setIncumbent(m_incumbent);
+      long long result = search->improve(order, crossings);
+      if (result < crossings)
+        crossings = result, improved = true;
+    }
+  }
+  return crossings;
+}
+
+long long MultiStartSearch::run(const std::vector<Start> &starts)
+{
+  const utils::Deadline &deadline = Environment::deadline();
+  int chains = this->chains();
+  /** Every run continues the sequence of seeds of the previous one */
+  int first = m_runs * chains;
+  m_runs++;
+  std::vector<Start> results(chains, {{}, LLONG_MAX});
+
+  library::ThreadPool::global().parallelFor(0, chains, [&](int c) {
+    if (deadline.expired())
+      return;
+    unsigned long long seed = chainSeed(first + c);
+    std::mt19937_64 random(seed);
+    const auto &[start, start_crossings] = starts[c % starts.size()];
+    std::vector<int> order = start;
+    long long crossings = start_crossings;
+    if (order.empty())
+    {
+      order = m_graph.getB();
+      std::shuffle(order.begin(), order.end(), random);
+      crossings = numberOfCrossings(order);
+    }
+    else if (c >= (int)starts.size())
+    {
+      crossings += perturb(order, random, m_matrix.get());
+    }
+
+    crossings = descend(order, crossings);
+    publish(order, crossings);
+    results[c] = {std::move(order), crossings};
+    std::ostringstream log;
+    log << "multistart: chain " << first + c << " seed " << seed
+        << " crossings " << crossings << "\n";
+    std::cerr << log.str();
+  });
+
+  /** Ties go to the first chain, so that a seed gives a single answer */
+  for (const auto &start : starts)
+  {
+    if (!start.first.empty())
+      results.push_back(start);
+  }
+  auto best = std::min_element(
+      results.begin(), results.end(),
+      [](const Start &a, const Start &b) { return a.second < b.second; });
+  m_order = best->first;
+  long long crossings = best->second;
+  assert(numberOfCrossings(m_order) == crossings);
+  return crossings;
+}
+
+long long MultiStartSearch::improve(std::vector<int> &order,
+                                    long long crossings)
+{
+  crossings = run({{order, crossings}, {{}, 0}});
+  order = m_order;
+  return crossings;
+}
+
+long long MultiStartSearch::solve()
+{
+  barycenter::BarycenterHeuristic barycenter(m_graph);
+  median::MedianHeuristic median(m_graph);
+  std::vector<Start> starts;
+  for (ApproximationRoutine *h :
+       std::vector<ApproximationRoutine *>{&barycenter, &median})
+  {
+    long long crossings = h->solve();
+    std::vector<int> order;
+    h->explain(order);
+    starts.push_back({order, crossings});
+  }
+  starts.push_back({{}, 0});
+  return run(starts);
+}
+
+} // namespace multistart
+} // namespace heuristic
+} // namespace solver
+} // namespace banana
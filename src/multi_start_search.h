@@ -0,0 +1,87 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   Alan Prado
+ *
+ * This file is part of Banana, a one-sided crossing minimization solver.
+ *
+ * Copyright (c) 2024 by the authors listed in the file AUTHORS in the
+ * top-level source directory and their institutional affiliations. All rights
+ * reserved. See the file LICENSE.md in the top-level source directory for
+ * licensing information.
+ * ****************************************************************************
+ *
+ * Multi-start parallel local search.
+ */
+
+#ifndef __PACE2024__MULTI_START_SEARCH_H
+#define __PACE2024__MULTI_START_SEARCH_H
+
+#include "dense_crossing_matrix.h"
+#include "improvement_routine.h"
+
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace banana {
+namespace solver {
+namespace heuristic {
+namespace multistart {
+
+/**
+ * Multi-start local search
+ *
+ * Runs independent chains on the thread pool. Each chain takes a start (the
+ * barycenter and median orders in solve, the given order in improve, or a
+ * random order), perturbs it with random insertions unless it is the first
+ * chain of that start, and descends with exchanges and sifting until neither
+ * improves. Crossings are tracked with exact deltas along the chain.
+ *
+ * Chains share the solver's Incumbent, which publishes the best order and its
+ * crossings atomically, so every improvement of any chain survives a SIGTERM.
+ * The order returned is the best chain, ties going to the lowest chain, so a
+ * fixed seed and a fixed number of chains give the same answer with any
+ * number of threads. The default number of chains depends on the size of
+ * the pool, so reproducing a run on another machine needs an explicit
+ * 'chains' flag. Chains check the deadline before they start and between
+ * descents. numberOfCrossings is only used to count random starts and to
+ * verify the final order.
+ */
+class MultiStartSearch : public ImprovementRoutine
+{
+public:
+  MultiStartSearch(
+      graph::BipartiteGraph graph,
+      std::shared_ptr<const crossing::DenseCrossingMatrix> matrix = nullptr);
+  ~MultiStartSearch() override = default;
+  long long solve() override;
+  using ImprovementRoutine::improve;
+  long long improve(std::vector<int> &order, long long crossings) override;
+
+  /** Number of chains; 0 means one per thread of the pool, at least four */
+  void setChains(int chains);
+  int chains() const;
+  /** Seed of chain 'c', derived from Environment::seed() */
+  static unsigned long long chainSeed(int c);
+
+protected:
+  /** An order and its crossings; an empty order stands for a random one */
+  using Start = std::pair<std::vector<int>, long long>;
+
+  long long run(const std::vector<Start> &starts);
+  /** Local search until no routine improves 'order' */
+  long long descend(std::vector<int> &order, long long crossings) const;
+
+  std::shared_ptr<const crossing::DenseCrossingMatrix> m_matrix;
+  int m_chains;
+  /** Calls to run so far */
+  int m_runs;
+};
+
+} // namespace multistart
+} // namespace heuristic
+} // namespace solver
+} // namespace banana
+
+#endif // __PACE2024__MULTI_START_SEARCH_H
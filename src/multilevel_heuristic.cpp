@@ -0,0 +1,349 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   Alan Prado
+ *
+ * This file is part of Banana, a one-sided crossing minimization solver.
+ *
+ * Copyright (c) 2024 by the authors listed in the file AUTHORS in the
+ * top-level source directory and their institutional affiliations. All rights
+ * reserved. See the file LICENSE.md in the top-level source directory for
+ * licensing information.
+ * ****************************************************************************
+ *
+ * Multilevel coarsen-solve-refine heuristic.
+ */
+
+#include "multilevel_heuristic.h"
+#include "environment.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <climits>
+#include <iostream>
+
+namespace banana {
+namespace solver {
+namespace heuristic {
+namespace multilevel {
+
+/** Levels are coarsened until they have at most COARSEST_SIZE vertices */
+const int COARSEST_SIZE = 2048;
+const int MAX_LEVELS = 32;
+/** Coarsening stops when a level keeps more than this fraction of vertices */
+const double MIN_SHRINK = 0.95;
+/** Vertices of A with more neighbors are not scanned for matches */
+const int HUB_DEGREE = 64;
+const int MAX_SWEEPS = 16;
+
+MultilevelHeuristic::MultilevelHeuristic(graph::BipartiteGraph graph)
+    : ApproximationRoutine(graph), m_nA(graph.countVerticesA()),
+      m_random(Environment::seed())
+{}
+
+std::pair<long long, long long>
+MultilevelHeuristic::crossings(const Level &level, int u, int v)
+{
+  /** As in CrossingMatrix::pairCrossings, with multiplicities */
+  auto before = [&](int x, int y) {
+    long long res = 0, less = 0;
+    int j = level.start[y];
+    for (int i = level.start[x]; i < level.start[x + 1]; i++)
+    {
+      while (j < level.start[y + 1] && level.column[j] < level.column[i])
+        less += level.weight[j++];
+      res += less * level.weight[i];
+    }
+    return res;
+  };
+  return {before(u, v), before(v, u)};
+}
+
+MultilevelHeuristic::Level MultilevelHeuristic::coarsen(Level &fine)
+{
+  int n = fine.size();
+  /** Edges of each vertex of A, as (vertex of B, weight) */
+  std::vector<std::vector<std::pair<int, int>>> by_a(m_nA);
+  for (int v = 0; v < n; v++)
+  {
+    for (int i = fine.start[v]; i < fine.start[v + 1]; i++)
+    {
+      by_a[fine.column[i]].push_back({v, fine.weight[i]});
+    }
+  }
+
+  std::vector<int> match(n, -1), visit(n);
+  for (int v = 0; v < n; v++)
+  {
+    visit[v] = v;
+  }
+  std::shuffle(visit.begin(), visit.end(), m_random);
+
+  std::vector<long long> shared(n, 0);
+  std::vector<int> touched;
+  for (int u : visit)
+  {
+    if (match[u] != -1)
+      continue;
+    for (int i = fine.start[u]; i < fine.start[u + 1]; i++)
+    {
+      /** Only the vertices next to u are scanned in the lists of hubs */
+      const auto &edges = by_a[fine.column[i]];
+      int first = 0, last = edges.size();
+      if (last > HUB_DEGREE)
+      {
+        int p = std::lower_bound(edges.begin(), edges.end(),
+                                 std::make_pair(u, INT_MIN)) -
+                edges.begin();
+        first = std::max(0, p - HUB_DEGREE / 2);
+        last = std::min(last, p + HUB_DEGREE / 2);
+      }
+      for (int k = first; k < last; k++)
+      {
+        auto [v, w] = edges[k];
+        if (v == u || match[v] != -1)
+          continue;
+        if (shared[v] == 0)
+          touched.push_back(v);
+        shared[v] += std::min(w, fine.weight[i]);
+      }
+    }
+    int best = -1;
+    for (int v : touched)
+    {
+      if (best == -1 || shared[v] > shared[best])
+        best = v;
+      shared[v] = 0;
+    }
+    touched.clear();
+    if (best != -1)
+      match[u] = best, match[best] = u;
+  }
+
+  /**
+   * Vertices without a partner (isolated ones, or leaves of private
+   * neighbors) are paired with the next one in barycenter order, so that
+   * every level still halves the graph
+   */
+  std::vector<std::pair<double, int>> unmatched;
+  for (int v = 0; v < n; v++)
+  {
+    if (match[v] != -1)
+      continue;
+    long long sum = 0, total = 0;
+    for (int i = fine.start[v]; i < fine.start[v + 1]; i++)
+    {
+      sum += (long long)fine.column[i] * fine.weight[i];
+      total += fine.weight[i];
+    }
+    unmatched.push_back({total == 0 ? -1 : (double)sum / total, v});
+  }
+  std::sort(unmatched.begin(), unmatched.end());
+  for (int k = 0; k + 1 < (int)unmatched.size(); k += 2)
+  {
+    int u = unmatched[k].second, v = unmatched[k + 1].second;
+    match[u] = v, match[v] = u;
+  }
+
+  Level coarse;
+  fine.parent.assign(n, -1);
+  for (int v = 0; v < n; v++)
+  {
+    if (fine.parent[v] != -1)
+      continue;
+    fine.parent[v] = coarse.start.size();
+    coarse.start.push_back(coarse.column.size());
+
+    /** Union of the sorted edges of v and its match */
+    int u = match[v] == -1 ? v : match[v];
+    int i = fine.start[v], j = fine.start[u];
+    int i_end = fine.start[v + 1], j_end = u == v ? j : fine.start[u + 1];
+    fine.parent[u] = fine.parent[v];
+    while (i < i_end || j < j_end)
+    {
+      int a;
+      int w = 0;
+      if (j == j_end || (i < i_end && fine.column[i] <= fine.column[j]))
+        a = fine.column[i];
+      else
+        a = fine.column[j];
+      if (i < i_end && fine.column[i] == a)
+        w += fine.weight[i++];
+      if (j < j_end && fine.column[j] == a)
+        w += fine.weight[j++];
+      coarse.column.push_back(a);
+      coarse.weight.push_back(w);
+    }
+  }
+  coarse.start.push_back(coarse.column.size());
+  return coarse;
+}
+
+std::vector<int>
+MultilevelHeuristic::solveCoarsest(const Level &level) const
+{
+  int n = level.size();
+  std::vector<double> barycenter(n, 0);
+  for (int v = 0; v < n; v++)
+  {
+    long long sum = 0, total = 0;
+    for (int i = level.start[v]; i < level.start[v + 1]; i++)
+    {
+      sum += (long long)level.column[i] * level.weight[i];
+      total += level.weight[i];
+    }
+    barycenter[v] = total == 0 ? 0 : (double)sum / total;
+  }
+  std::vector<int> order(n);
+  for (int v = 0; v < n; v++)
+  {
+    order[v] = v;
+  }
+  std::stable_sort(order.begin(), order.end(), [&](int u, int v) {
+    return barycenter[u] < barycenter[v];
+  });
+  if (n > COARSEST_SIZE)
+  {
+    refine(level, order);
+    return order;
+  }
+
+  /** Sifting with c_{u,v} - c_{v,u} for every pair */
+  std::vector<long long> delta((size_t)n * n);
+  library::ThreadPool::global().parallelFor(
+      0, n,
+      [&](int u) {
+        for (int v = u + 1; v < n; v++)
+        {
+          auto [uv, vu] = crossings(level, u, v);
+          delta[(size_t)u * n + v] = uv - vu;
+          delta[(size_t)v * n + u] = vu - uv;
+        }
+      },
+      16);
+
+  const utils::Deadline &deadline = Environment::deadline();
+  bool improved = true;
+  for (int sweep = 0; improved && sweep < MAX_SWEEPS && !deadline.expired();
+       sweep++)
+  {
+    improved = false;
+    std::vector<int> snapshot = order;
+    for (int v : snapshot)
+    {
+      int p = std::find(order.begin(), order.end(), v) - order.begin();
+      /** Moving v across u changes the crossings by c_{u,v} - c_{v,u} */
+      long long best = 0, sum = 0;
+      int target = p;
+      for (int k = p - 1; k >= 0; k--)
+      {
+        sum -= delta[(size_t)order[k] * n + v];
+        if (sum < best)
+          best = sum, target = k;
+      }
+      sum = 0;
+      for (int k = p + 1; k < n; k++)
+      {
+        sum += delta[(size_t)order[k] * n + v];
+        if (sum < best)
+          best = sum, target = k;
+      }
+      if (target < p)
+        std::rotate(order.begin() + target, order.begin() + p,
+                    order.begin() + p + 1);
+      else if (target > p)
+        std::rotate(order.begin() + p, order.begin() + p + 1,
+                    order.begin() + target + 1);
+      improved = improved || target != p;
+    }
+  }
+  return order;
+}
+
+std::vector<int>
+MultilevelHeuristic::project(const Level &fine,
+                             const std::vector<int> &coarse) const
+{
+  std::vector<std::vector<int>> children(coarse.size());
+  for (int v = 0; v < fine.size(); v++)
+  {
+    children[fine.parent[v]].push_back(v);
+  }
+
+  std::vector<int> order;
+  for (int c : coarse)
+  {
+    std::vector<int> &pair = children[c];
+    if (pair.size() == 2 && crossings(fine, pair[1], pair[0]).first <
+                                crossings(fine, pair[0], pair[1]).first)
+      std::swap(pair[0], pair[1]);
+    order.insert(order.end(), pair.begin(), pair.end());
+  }
+  return order;
+}
+
+void MultilevelHeuristic::refine(const Level &level,
+                                 std::vector<int> &order) const
+{
+  const utils::Deadline &deadline = Environment::deadline();
+  bool improved = true;
+  for (int sweep = 0; improved && sweep < MAX_SWEEPS && !deadline.expired();
+       sweep++)
+  {
+    improved = false;
+    for (int i = 0; i + 1 < (int)order.size(); i++)
+    {
+      auto [uv, vu] = crossings(level, order[i], order[i + 1]);
+      if (vu < uv)
+        std::swap(order[i], order[i + 1]), improved = true;
+    }
+  }
+}
+
+long long MultilevelHeuristic::solve()
+{
+  int n = m_graph.countVerticesB();
+  std::vector<Level> levels(1);
+  Level &finest = levels[0];
+  finest.start.push_back(0);
+  for (int v = 0; v < n; v++)
+  {
+    std::vector<int> neighbors = m_graph.neighborhood(v + m_nA);
+    std::sort(neighbors.begin(), neighbors.end());
+    finest.column.insert(finest.column.end(), neighbors.begin(),
+                         neighbors.end());
+    finest.start.push_back(finest.column.size());
+  }
+  finest.weight.assign(finest.column.size(), 1);
+
+  while (levels.back().size() > COARSEST_SIZE &&
+         (int)levels.size() < MAX_LEVELS)
+  {
+    Level coarse = coarsen(levels.back());
+    if (coarse.size() > MIN_SHRINK * levels.back().size())
+      break;
+    levels.push_back(std::move(coarse));
+  }
+
+  std::vector<int> order = solveCoarsest(levels.back());
+  const utils::Deadline &deadline = Environment::deadline();
+  for (int l = levels.size() - 2; l >= 0; l--)
+  {
+    order = project(levels[l], order);
+    if (!deadline.expired())
+      refine(levels[l], order);
+  }
+  std::cerr << "multilevel: " << levels.size() << " levels, coarsest "
+            << levels.back().size() << std::endl;
+
+  m_order.clear();
+  for (int v : order)
+  {
+    m_order.push_back(v + m_nA);
+  }
+  return numberOfCrossings(m_order);
+}
+
+} // namespace multilevel
+} // namespace heuristic
+} // namespace solver
+} // namespace banana
@@ -0,0 +1,89 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   Alan Prado
+ *
+ * This file is part of Banana, a one-sided crossing minimization solver.
+ *
+ * Copyright (c) 2024 by the authors listed in the file AUTHORS in the
+ * top-level source directory and their institutional affiliations. All rights
+ * reserved. See the file LICENSE.md in the top-level source directory for
+ * licensing information.
+ * ****************************************************************************
+ *
+ * Multilevel coarsen-solve-refine heuristic.
+ */
+
+#ifndef __PACE2024__MULTILEVEL_HEURISTIC_H
+#define __PACE2024__MULTILEVEL_HEURISTIC_H
+
+#include "approximation_routine.h"
+
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace banana {
+namespace solver {
+namespace heuristic {
+namespace multilevel {
+
+/**
+ * Multilevel heuristic
+ *
+ * Coarsens B by merging pairs of vertices with similar neighborhoods, as
+ * graph partitioners do: each vertex, in random order, is matched to the
+ * unmatched vertex that shares the most edge weight with it. A matched pair
+ * becomes a super-vertex whose edges are the union of theirs, with the
+ * multiplicities as weights, and the crossings of two super-vertices are
+ * \sum w_a w_b over their crossing edges. Levels are stored in weighted CSR
+ * form, so no level needs O(n^2) memory; only the coarsest one, once it has
+ * at most COARSEST_SIZE vertices, gets a dense crossing matrix.
+ *
+ * The coarsest level is ordered by weighted barycenter and sifting. Each
+ * order is then projected to the finer level, with the two vertices of a
+ * pair in their better relative order, and refined with weighted adjacent
+ * swaps. When the deadline expires, the remaining levels are only projected.
+ */
+class MultilevelHeuristic : public ApproximationRoutine
+{
+public:
+  MultilevelHeuristic(graph::BipartiteGraph graph);
+  ~MultilevelHeuristic() override = default;
+  long long solve() override;
+
+protected:
+  /** Weighted CSR form of B: edges of vertex v are [start[v], start[v+1]) */
+  struct Level
+  {
+    std::vector<int> start;
+    /** Neighbor in A and multiplicity of each edge, sorted by neighbor */
+    std::vector<int> column, weight;
+    /** Vertex of the next (coarser) level each vertex was merged into */
+    std::vector<int> parent;
+
+    int size() const { return (int)start.size() - 1; }
+  };
+
+  /** Crossings (u before v, v before u) of two vertices of 'level' */
+  static std::pair<long long, long long> crossings(const Level &level, int u,
+                                                   int v);
+  /** Matches the vertices of 'fine' and returns the coarser level */
+  Level coarsen(Level &fine);
+  /** Weighted barycenter and sifting on the coarsest level */
+  std::vector<int> solveCoarsest(const Level &level) const;
+  /** Expands an order of the coarser level to 'fine' */
+  std::vector<int> project(const Level &fine,
+                           const std::vector<int> &coarse) const;
+  /** Weighted adjacent swaps until none improves */
+  void refine(const Level &level, std::vector<int> &order) const;
+
+  int m_nA;
+  std::mt19937_64 m_random;
+};
+
+} // namespace multilevel
+} // namespace heuristic
+} // namespace solver
+} // namespace banana
+
+#endif // __PACE2024__MULTILEVEL_HEURISTIC_H
@@ -61,6 +61,16 @@ void Options::parseArguments(int argc, char *argv[])
   int opt;
 
   struct option longopts[] = {
+      /** General options */
+      {"time-limit", required_argument, nullptr,
+       static_cast<uint32_t>(Flags::TimeLimit)},
+      {"anytime", no_argument, nullptr, static_cast<uint32_t>(Flags::Anytime)},
+      {"seed", required_argument, nullptr, static_cast<uint32_t>(Flags::Seed)},
+      /** Heuristic options */
+      {"chains", required_argument, nullptr,
+       static_cast<uint32_t>(Flags::Chains)},
+      {"beam-width", required_argument, nullptr,
+       static_cast<uint32_t>(Flags::BeamWidth)},
       /** IP options */
       {"ipsolver", required_argument, nullptr,
        static_cast<uint32_t>(Flags::IPSolverMode)},
@@ -68,6 +78,16 @@ void Options::parseArguments(int argc, char *argv[])
        static_cast<uint32_t>(Flags::IPFormulation)},
       {"ipprefixconstraints", required_argument, nullptr,
        static_cast<uint32_t>(Flags::IPPrefixConstraints)},
+      {"ipprobing", required_argument, nullptr,
+       static_cast<uint32_t>(Flags::IPProbing)},
+      {"iplagrangian", required_argument, nullptr,
+       static_cast<uint32_t>(Flags::IPLagrangian)},
+      {"ipcutrounds", required_argument, nullptr,
+       static_cast<uint32_t>(Flags::IPCutRounds)},
+      {"iplpfirst", no_argument, nullptr,
+       static_cast<uint32_t>(Flags::IPLPFirst)},
+      {"ipbranching", required_argument, nullptr,
+       static_cast<uint32_t>(Flags::IPBranching)},
       /** Verification options */
       {"verify", required_argument, nullptr,
        static_cast<uint32_t>(Flags::VerifyMode)},
@@ -76,9 +96,44 @@ void Options::parseArguments(int argc, char *argv[])
   while ((opt = getopt_long(argc, argv, "", longopts, 0)) != -1)
   {
     const std::string or_tools_prefix = "or-tools:";
-    auto optarg_s = std::string{optarg};
+    auto optarg_s = std::string{optarg ? optarg : ""};
     switch (opt)
     {
+    /** General options */
+    case static_cast<uint32_t>(Flags::TimeLimit):
+      general.timeLimit = std::stod(optarg_s);
+      if (general.timeLimit < 0)
+      {
+        throw std::invalid_argument("Invalid Time Limit: " +
+                                    std::string{optarg});
+      }
+      break;
+    case static_cast<uint32_t>(Flags::Anytime):
+      general.anytime = true;
+      break;
+    case static_cast<uint32_t>(Flags::Seed):
+      general.seed = std::stoll(optarg_s);
+      if (general.seed < 0)
+      {
+        throw std::invalid_argument("Invalid Seed: " + std::string{optarg});
+      }
+      break;
+    /** Heuristic options */
+    case static_cast<uint32_t>(Flags::Chains):
+      heuristic.chains = std::stoi(optarg_s);
+      if (heuristic.chains < 0)
+      {
+        throw std::invalid_argument("Invalid Chains: " + std::string{optarg});
+      }
+      break;
+    case static_cast<uint32_t>(Flags::BeamWidth):
+      heuristic.beamWidth = std::stoi(optarg_s);
+      if (heuristic.beamWidth < 1)
+      {
+        throw std::invalid_argument("Invalid Beam Width: " +
+                                    std::string{optarg});
+      }
+      break;
     /** IP options */
     case static_cast<uint32_t>(Flags::IPSolverMode):
       if (!strcmp(optarg, "lpsolve"))
@@ -147,6 +202,52 @@ void Options::parseArguments(int argc, char *argv[])
                                     std::string{optarg});
       }
       break;
+    case static_cast<uint32_t>(Flags::IPProbing):
+      ip.probingTimeLimit = std::stod(optarg_s);
+      if (ip.probingTimeLimit < 0)
+      {
+        throw std::invalid_argument("Invalid IP Probing Time Limit: " +
+                                    std::string{optarg});
+      }
+      break;
+    case static_cast<uint32_t>(Flags::IPLagrangian):
+      ip.lagrangianIterations = std::stoi(optarg_s);
+      if (ip.lagrangianIterations < 0)
+      {
+        throw std::invalid_argument("Invalid IP Lagrangian Iterations: " +
+                                    std::string{optarg});
+      }
+      break;
+    case static_cast<uint32_t>(Flags::IPCutRounds):
+      ip.cutRounds = std::stoi(optarg_s);
+      if (ip.cutRounds < 0)
+      {
+        throw std::invalid_argument("Invalid IP Cut Rounds: " +
+                                    std::string{optarg});
+      }
+      break;
+    case static_cast<uint32_t>(Flags::IPLPFirst):
+      ip.lpFirst = true;
+      break;
+    case static_cast<uint32_t>(Flags::IPBranching):
+      if (!strcmp(optarg, "default"))
+      {
+        ip.branching = IPBranching::DEFAULT;
+      }
+      else if (!strcmp(optarg, "priority"))
+      {
+        ip.branching = IPBranching::PRIORITY;
+      }
+      else if (!strcmp(optarg, "score"))
+      {
+        ip.branching = IPBranching::SCORE;
+      }
+      else
+      {
+        throw std::invalid_argument("Invalid IP Branching: " +
+                                    std::string{optarg});
+      }
+      break;
     /** Verify options */
     case static_cast<uint32_t>(Flags::VerifyMode):
       verify.verifyMode = VerifyMode::COMPLETE;
@@ -22,11 +22,23 @@ namespace banana::options {
 
 enum class Flags
 {
+  /** General options */
+  TimeLimit,
+  Anytime,
+  Seed,
+  /** Heuristic options */
+  Chains,
+  BeamWidth,
   /** IP options */
   IPSolverMode,
   IPHeuristicMode,
   IPFormulation,
   IPPrefixConstraints,
+  IPProbing,
+  IPLagrangian,
+  IPCutRounds,
+  IPLPFirst,
+  IPBranching,
   /** Verify options */
   VerifyMode
 };
@@ -85,6 +97,14 @@ enum class IPHeuristicMode
   __MAX_VALUE = OFF
 };
 
+enum class IPBranching
+{
+  DEFAULT,
+  PRIORITY,
+  SCORE,
+  __MAX_VALUE = DEFAULT
+};
+
 struct HolderIP
 {
   IPSolverMode solverMode = IPSolverMode::LPSOLVE;
@@ -92,6 +112,33 @@ struct HolderIP
   IPFormulation formulation = IPFormulation::SHORTER;
   IPPrefixConstraints prefixConstraints = IPPrefixConstraints::NONE;
   IPHeuristicMode heuristicMode = IPHeuristicMode::OFF;
+  /** Time limit (in seconds) for orientation probing; 0 disables it */
+  double probingTimeLimit = 0;
+  /** Subgradient iterations of the Lagrangian bound; 0 disables it */
+  int lagrangianIterations = 0;
+  /** Rounds of ordering cuts before solving the shorter formulation */
+  int cutRounds = 0;
+  /** Solve the relaxation first, and skip B&B if it is integral */
+  bool lpFirst = false;
+  IPBranching branching = IPBranching::DEFAULT;
+};
+
+struct HolderGeneral
+{
+  /** Wall-clock limit (in seconds) for the whole run; 0 means none */
+  double timeLimit = 0;
+  /** Run the heuristic pipeline only, printing its best order when done */
+  bool anytime = false;
+  /** Seed of the randomized heuristics; -1 draws one from the system */
+  long long seed = -1;
+};
+
+struct HolderHeuristic
+{
+  /** Local search chains of the multi-start search; 0 means one per thread */
+  int chains = 0;
+  /** Prefixes kept at each depth of the beam search */
+  int beamWidth = 8;
 };
 
 struct HolderVerify
@@ -108,6 +155,8 @@ public:
   void parseArguments(int argc, char *argv[]);
   ~Options() = default;
 
+  HolderGeneral general;
+  HolderHeuristic heuristic;
   HolderIP ip;
   HolderVerify verify;
 };
@@ -0,0 +1,306 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   Alan Prado
+ *
+ * This file is part of Banana, a one-sided crossing minimization solver.
+ *
+ * Copyright (c) 2024 by the authors listed in the file AUTHORS in the
+ * top-level source directory and their institutional affiliations. All rights
+ * reserved. See the file LICENSE.md in the top-level source directory for
+ * licensing information.
+ * ****************************************************************************
+ *
+ * Separation of facets of the linear ordering polytope.
+ */
+
+#include "ordering_cuts.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <set>
+
+namespace banana {
+namespace solver {
+namespace ip {
+
+const double EPSILON = 1e-6;
+/** Minimum violation of a returned cut */
+const double MIN_VIOLATION = 1e-3;
+/** Slack of the 3-cycles used as seeds of Moebius ladders */
+const double TIGHT_SLACK = 0.05;
+/** Fractional arcs considered as pales, and how many of them start a fence */
+const int FENCE_CANDIDATES = 1000;
+const int FENCE_STARTS = 250;
+const int LADDER_SEEDS = 500;
+
+OrderingCuts::OrderingCuts(const graph::BipartiteGraph &graph,
+                           crossing::CrossingMatrix &cm)
+    : m_offset(graph.countVerticesA()),
+      m_pairs(graph, cm.getOrientablePairs())
+{
+}
+
+double OrderingCuts::arc(const std::vector<double> &x, int u, int v) const
+{
+  int p = m_pairs.index(u, v);
+  if (p != -1)
+  {
+    return u < v ? x[p] : 1 - x[p];
+  }
+  return m_pairs.forcedBefore(u, v) ? 1 : 0;
+}
+
+bool OrderingCuts::makeCut(const std::vector<double> &x,
+                           const std::vector<std::pair<int, int>> &arcs,
+                           int rhs, Cut &cut) const
+{
+  cut.pairs.clear(), cut.coefs.clear();
+  cut.rhs = rhs;
+  for (auto [u, v] : arcs)
+  {
+    int p = m_pairs.index(u, v);
+    if (p == -1)
+    {
+      cut.rhs -= arc(x, u, v);
+      continue;
+    }
+    /** y_{u,v} = x_p if u < v, otherwise 1 - x_p */
+    double coef = u < v ? 1 : -1;
+    if (u > v)
+      cut.rhs -= 1;
+    auto it = std::find(cut.pairs.begin(), cut.pairs.end(), p);
+    if (it == cut.pairs.end())
+    {
+      cut.pairs.push_back(p);
+      cut.coefs.push_back(coef);
+    }
+    else
+    {
+      cut.coefs[it - cut.pairs.begin()] += coef;
+    }
+  }
+
+  cut.violation = -cut.rhs;
+  for (int s = 0; s < (int)cut.pairs.size(); s++)
+  {
+    cut.violation += cut.coefs[s] * x[cut.pairs[s]];
+  }
+  return !cut.pairs.empty() && cut.violation > MIN_VIOLATION;
+}
+
+void OrderingCuts::separateFences(const std::vector<double> &x,
+                                  std::vector<Cut> &cuts) const
+{
+  /** Pales are taken among the fractional arcs, largest values first */
+  std::vector<std::pair<double, std::pair<int, int>>> candidates;
+  for (int p = 0; p < m_pairs.size(); p++)
+  {
+    if (x[p] < EPSILON || x[p] > 1 - EPSILON)
+      continue;
+    auto [i, j] = m_pairs.pairs()[p];
+    candidates.push_back({x[p], {i, j}});
+    candidates.push_back({1 - x[p], {j, i}});
+  }
+  std::sort(candidates.rbegin(), candidates.rend());
+  if ((int)candidates.size() > FENCE_CANDIDATES)
+    candidates.resize(FENCE_CANDIDATES);
+
+  int starts = std::min<int>(candidates.size(), FENCE_STARTS);
+  std::vector<std::vector<Cut>> found(starts);
+  library::ThreadPool::global().parallelFor(
+      0, starts,
+      [&](int s) {
+        std::vector<std::pair<int, int>> pales = {candidates[s].second};
+        double total = candidates[s].first;
+        for (int k = 2; k <= 4; k++)
+        {
+          /** Adds the pale with the largest gain on disjoint vertices */
+          double best_gain = -1;
+          std::pair<int, int> best_pale;
+          for (const auto &[y, pale] : candidates)
+          {
+            auto [u, w] = pale;
+            bool disjoint = true;
+            double gain = y;
+            for (auto [ui, wi] : pales)
+            {
+              if (u == ui || u == wi || w == ui || w == wi)
+              {
+                disjoint = false;
+                break;
+              }
+              gain += arc(x, wi, u) + arc(x, w, ui);
+            }
+            if (disjoint && gain > best_gain)
+              best_gain = gain, best_pale = pale;
+          }
+          if (best_gain < 0)
+            break;
+          pales.push_back(best_pale);
+          total += best_gain;
+
+          int rhs = k * k - k + 1;
+          if (k < 3 || total < rhs + MIN_VIOLATION)
+            continue;
+          std::vector<std::pair<int, int>> arcs;
+          for (int i = 0; i < k; i++)
+          {
+            arcs.push_back(pales[i]);
+            for (int j = 0; j < k; j++)
+            {
+              if (i != j)
+                arcs.push_back({pales[j].second, pales[i].first});
+            }
+          }
+          Cut cut;
+          if (makeCut(x, arcs, rhs, cut))
+            found[s].push_back(cut);
+        }
+      },
+      4);
+
+  for (auto &f : found)
+  {
+    cuts.insert(cuts.end(), f.begin(), f.end());
+  }
+}
+
+void OrderingCuts::separateLadders(const std::vector<double> &x,
+                                   std::vector<Cut> &cuts) const
+{
+  /**
+   * Tight 3-cycles v_0 -> v_1 -> v_2 -> v_0 with some fractional arc. As in
+   * the transitivity constraints, every triple has a center adjacent to the
+   * others, and is enumerated from its smallest center only.
+   */
+  int n = m_pairs.countVertices();
+  std::vector<std::vector<std::pair<double, std::vector<int>>>> tight(n);
+  library::ThreadPool::global().parallelFor(
+      0, n,
+      [&](int c) {
+        int center = c + m_offset;
+        const auto &neighbors = m_pairs.neighbors(center);
+        for (int x1 = 0; x1 < (int)neighbors.size(); x1++)
+        {
+          for (int x2 = x1 + 1; x2 < (int)neighbors.size(); x2++)
+          {
+            auto [a, pa] = neighbors[x1];
+            auto [b, pb] = neighbors[x2];
+            if (center > a && m_pairs.index(a, b) != -1)
+              continue;
+            bool fractional = (x[pa] > EPSILON && x[pa] < 1 - EPSILON) ||
+                              (x[pb] > EPSILON && x[pb] < 1 - EPSILON);
+            if (!fractional)
+              continue;
+            double forward =
+                arc(x, center, a) + arc(x, a, b) + arc(x, b, center);
+            double backward = 3 - forward;
+            if (forward >= 2 - TIGHT_SLACK)
+              tight[c].push_back({forward, {center, a, b}});
+            if (backward >= 2 - TIGHT_SLACK)
+              tight[c].push_back({backward, {center, b, a}});
+          }
+        }
+      },
+      16);
+
+  std::vector<std::pair<double, std::vector<int>>> seeds;
+  for (auto &t : tight)
+  {
+    seeds.insert(seeds.end(), t.begin(), t.end());
+  }
+  std::sort(seeds.rbegin(), seeds.rend());
+  if ((int)seeds.size() > LADDER_SEEDS)
+    seeds.resize(LADDER_SEEDS);
+
+  /**
+   * Arcs of the ladder are v_i -> v_{i+1} and v_{i+2} -> v_i. Each new vertex
+   * closes one more 3-cycle, and the last ones also close the ring.
+   */
+  std::vector<std::vector<Cut>> found(seeds.size() * 3);
+  library::ThreadPool::global().parallelFor(
+      0, found.size(),
+      [&](int s) {
+        std::vector<int> v = seeds[s / 3].second;
+        std::rotate(v.begin(), v.begin() + s % 3, v.end());
+        double total = seeds[s / 3].first;
+        auto gain = [&](int i, int w) {
+          double g = arc(x, v[i - 1], w) + arc(x, w, v[i - 2]);
+          if (i == 5)
+            g += arc(x, v[0], w);
+          if (i == 6)
+            g += arc(x, w, v[0]) + arc(x, v[1], w);
+          return g;
+        };
+        for (int i = 3; i < 7; i++)
+        {
+          double best_gain = -1;
+          int best_vertex = -1;
+          for (auto [w, p] : m_pairs.neighbors(v[i - 1]))
+          {
+            if (std::find(v.begin(), v.end(), w) != v.end())
+              continue;
+            double g = gain(i, w);
+            if (g > best_gain)
+              best_gain = g, best_vertex = w;
+          }
+          if (best_vertex == -1)
+            return;
+          v.push_back(best_vertex);
+          total += best_gain;
+        }
+        if (total < 10 + MIN_VIOLATION)
+          return;
+
+        std::vector<std::pair<int, int>> arcs;
+        for (int i = 0; i < 7; i++)
+        {
+          arcs.push_back({v[i], v[(i + 1) % 7]});
+          arcs.push_back({v[(i + 2) % 7], v[i]});
+        }
+        Cut cut;
+        if (makeCut(x, arcs, 10, cut))
+          found[s].push_back(cut);
+      },
+      4);
+
+  for (auto &f : found)
+  {
+    cuts.insert(cuts.end(), f.begin(), f.end());
+  }
+}
+
+std::vector<OrderingCuts::Cut>
+OrderingCuts::separate(const std::vector<double> &x, int max_cuts) const
+{
+  std::vector<Cut> candidates;
+  separateFences(x, candidates);
+  separateLadders(x, candidates);
+  std::sort(candidates.begin(), candidates.end(),
+            [](const Cut &a, const Cut &b) {
+              return a.violation > b.violation;
+            });
+
+  /** The same inequality is often reached from several starts */
+  std::vector<Cut> cuts;
+  std::set<std::vector<std::pair<int, double>>> seen;
+  for (Cut &cut : candidates)
+  {
+    if ((int)cuts.size() >= max_cuts)
+      break;
+    std::vector<std::pair<int, double>> key;
+    for (int s = 0; s < (int)cut.pairs.size(); s++)
+    {
+      key.push_back({cut.pairs[s], cut.coefs[s]});
+    }
+    std::sort(key.begin(), key.end());
+    key.push_back({-1, cut.rhs});
+    if (seen.insert(key).second)
+      cuts.push_back(std::move(cut));
+  }
+  return cuts;
+}
+
+} // namespace ip
+} // namespace solver
+} // namespace banana
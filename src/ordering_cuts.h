@@ -0,0 +1,92 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   Alan Prado
+ *
+ * This file is part of Banana, a one-sided crossing minimization solver.
+ *
+ * Copyright (c) 2024 by the authors listed in the file AUTHORS in the
+ * top-level source directory and their institutional affiliations. All rights
+ * reserved. See the file LICENSE.md in the top-level source directory for
+ * licensing information.
+ * ****************************************************************************
+ *
+ * Separation of facets of the linear ordering polytope.
+ */
+
+#ifndef __PACE2024__ORDERING_CUTS_H
+#define __PACE2024__ORDERING_CUTS_H
+
+#include "bipartite_graph.h"
+#include "crossing_matrix.h"
+
+#include <utility>
+#include <vector>
+
+namespace banana {
+namespace solver {
+namespace ip {
+
+/**
+ * Ordering cuts
+ *
+ * The 3-cycle inequalities of the shorter formulation do not describe the
+ * linear ordering polytope, and their LP bound is weak on dense instances.
+ * This class separates two classic facet classes from a fractional solution,
+ * written in terms of arcs y_{u,v} (1 iff u precedes v):
+ *
+ *   k-fence, k \in \{3, 4\}: vertices u_1..u_k, w_1..w_k,
+ *     \sum_i y_{u_i,w_i} + \sum_{i \neq j} y_{w_j,u_i} \leq k^2 - k + 1
+ *
+ *   Moebius ladder of seven 3-cycles: vertices v_0..v_6 (indexes mod 7),
+ *     \sum_i y_{v_i,v_{i+1}} + y_{v_{i+2},v_i} \leq 10
+ *
+ * Both are found greedily: fences grow from fractional arcs used as pales,
+ * and ladders extend tight 3-cycles one triangle at a time. Cuts are
+ * returned over the variables of the shorter formulation, with the values of
+ * non-orientable pairs folded into the right hand side.
+ */
+class OrderingCuts
+{
+public:
+  /** Sparse row: \sum coefs * x_pairs \leq rhs */
+  struct Cut
+  {
+    std::vector<int> pairs;
+    std::vector<double> coefs;
+    double rhs;
+    double violation;
+  };
+
+  OrderingCuts(const graph::BipartiteGraph &graph,
+               crossing::CrossingMatrix &cm);
+  ~OrderingCuts() = default;
+
+  /**
+   * Returns at most 'max_cuts' of the most violated cuts. 'x' holds the value
+   * of each orientable pair (i, j), i < j, in sorted order.
+   */
+  std::vector<Cut> separate(const std::vector<double> &x, int max_cuts) const;
+
+protected:
+  /** Value of the arc (u, v) in the solution 'x' */
+  double arc(const std::vector<double> &x, int u, int v) const;
+  /** Builds the row of the inequality y(arcs) \leq rhs */
+  bool makeCut(const std::vector<double> &x,
+               const std::vector<std::pair<int, int>> &arcs, int rhs,
+               Cut &cut) const;
+
+  void separateFences(const std::vector<double> &x,
+                      std::vector<Cut> &cuts) const;
+  void separateLadders(const std::vector<double> &x,
+                       std::vector<Cut> &cuts) const;
+
+  int m_offset;
+  /** Orientable pairs (i, j), i < j */
+  crossing::OrientablePairs m_pairs;
+};
+
+} // namespace ip
+} // namespace solver
+} // namespace banana
+
+#endif // __PACE2024__ORDERING_CUTS_H
@@ -0,0 +1,182 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   Alan Prado
+ *
+ * This file is part of Banana, a one-sided crossing minimization solver.
+ *
+ * Copyright (c) 2024 by the authors listed in the file AUTHORS in the
+ * top-level source directory and their institutional affiliations. All rights
+ * reserved. See the file LICENSE.md in the top-level source directory for
+ * licensing information.
+ * ****************************************************************************
+ *
+ * Bound-based probing of the orientation of pairs of vertices.
+ */
+
+#include "orientation_probing.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace banana {
+namespace solver {
+namespace ip {
+
+/** Maximum number of implied relations followed by a single probe */
+const int PROPAGATION_LIMIT = 64;
+
+OrientationProbing::OrientationProbing(const graph::BipartiteGraph &graph,
+                                       crossing::CrossingMatrix &cm)
+    : m_pairs(graph, cm.getOrientablePairs()), m_lowerBound(0)
+{
+  for (auto [i, j] : m_pairs.pairs())
+  {
+    m_costs.push_back({cm(i, j), cm(j, i)});
+    m_lowerBound += std::min(cm(i, j), cm(j, i));
+  }
+  m_state.assign(m_pairs.size(), UNKNOWN);
+}
+
+bool OrientationProbing::knownBefore(int u, int v) const
+{
+  int p = m_pairs.index(u, v);
+  if (p != -1)
+  {
+    return m_state[p] == (u < v ? FORWARD : BACKWARD);
+  }
+  return m_pairs.forcedBefore(u, v);
+}
+
+long long OrientationProbing::extraCost(int p, Orientation o) const
+{
+  auto [forward, backward] = m_costs[p];
+  int cost = o == FORWARD ? forward : backward;
+  return cost - std::min(forward, backward);
+}
+
+long long OrientationProbing::probe(int u, int v, int upper_bound) const
+{
+  /** Pairs oriented by this probe only */
+  std::vector<std::pair<int, Orientation>> assumed;
+  std::vector<std::pair<int, int>> queue;
+  long long extra = 0;
+
+  auto orientation = [](int a, int b) { return a < b ? FORWARD : BACKWARD; };
+
+  auto before = [&](int a, int b) {
+    int p = m_pairs.index(a, b);
+    if (p == -1 || m_state[p] != UNKNOWN)
+      return knownBefore(a, b);
+    for (auto [q, o] : assumed)
+    {
+      if (q == p)
+        return o == orientation(a, b);
+    }
+    return false;
+  };
+
+  /** Assumes 'a' before 'b'. Returns false if it is a contradiction. */
+  auto assume = [&](int a, int b) {
+    int p = m_pairs.index(a, b);
+    if (p == -1)
+      return !knownBefore(b, a);
+    if (m_state[p] != UNKNOWN)
+      return m_state[p] == orientation(a, b);
+    for (auto [q, o] : assumed)
+    {
+      if (q == p)
+        return o == orientation(a, b);
+    }
+    assumed.push_back({p, orientation(a, b)});
+    extra += extraCost(p, orientation(a, b));
+    queue.push_back({a, b});
+    return true;
+  };
+
+  if (!assume(u, v))
+    return -1;
+
+  for (int head = 0; head < (int)queue.size() && head < PROPAGATION_LIMIT;
+       head++)
+  {
+    if (m_lowerBound + extra > upper_bound)
+      break;
+    auto [a, b] = queue[head];
+    /** w before a and a before b imply w before b */
+    for (auto [w, p] : m_pairs.neighbors(b))
+    {
+      if (w != a && before(w, a) && !assume(w, b))
+        return -1;
+    }
+    /** a before b and b before x imply a before x */
+    for (auto [x, p] : m_pairs.neighbors(a))
+    {
+      if (x != b && before(b, x) && !assume(a, x))
+        return -1;
+    }
+  }
+
+  return extra;
+}
+
+std::vector<std::pair<int, int>> OrientationProbing::run(int upper_bound,
+                                                         double time_limit)
+{
+  auto start = std::chrono::steady_clock::now();
+  auto expired = [&]() {
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count() > time_limit;
+  };
+
+  std::vector<std::pair<int, int>> fixed;
+  std::vector<Orientation> result(m_pairs.size());
+  bool changed = true;
+  while (changed && !expired())
+  {
+    changed = false;
+    std::fill(result.begin(), result.end(), UNKNOWN);
+
+    library::ThreadPool::global().parallelFor(
+        0, m_pairs.size(),
+        [&](int p) {
+          if (m_state[p] != UNKNOWN || expired())
+            return;
+          auto [i, j] = m_pairs.pairs()[p];
+          long long forward = probe(i, j, upper_bound);
+          if (forward == -1 || m_lowerBound + forward > upper_bound)
+          {
+            result[p] = BACKWARD;
+            return;
+          }
+          long long backward = probe(j, i, upper_bound);
+          if (backward == -1 || m_lowerBound + backward > upper_bound)
+          {
+            result[p] = FORWARD;
+          }
+        },
+        64);
+
+    /** Merge the round, updating the bound incrementally */
+    for (int p = 0; p < m_pairs.size(); p++)
+    {
+      if (result[p] == UNKNOWN)
+        continue;
+      auto [i, j] = m_pairs.pairs()[p];
+      m_state[p] = result[p];
+      m_lowerBound += extraCost(p, result[p]);
+      fixed.push_back(result[p] == FORWARD ? std::make_pair(i, j)
+                                           : std::make_pair(j, i));
+      changed = true;
+    }
+  }
+
+  return fixed;
+}
+
+long long OrientationProbing::lowerBound() const { return m_lowerBound; }
+
+} // namespace ip
+} // namespace solver
+} // namespace banana
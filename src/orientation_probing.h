@@ -0,0 +1,89 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   Alan Prado
+ *
+ * This file is part of Banana, a one-sided crossing minimization solver.
+ *
+ * Copyright (c) 2024 by the authors listed in the file AUTHORS in the
+ * top-level source directory and their institutional affiliations. All rights
+ * reserved. See the file LICENSE.md in the top-level source directory for
+ * licensing information.
+ * ****************************************************************************
+ *
+ * Bound-based probing of the orientation of pairs of vertices.
+ */
+
+#ifndef __PACE2024__ORIENTATION_PROBING_H
+#define __PACE2024__ORIENTATION_PROBING_H
+
+#include "bipartite_graph.h"
+#include "crossing_matrix.h"
+
+#include <utility>
+#include <vector>
+
+namespace banana {
+namespace solver {
+namespace ip {
+
+/**
+ * Bound-based probing
+ *
+ * Every orientable pair {u, v} contributes at least min(c_uv, c_vu) crossings
+ * to any order, so the sum of these minimums is a lower bound (LB) for the
+ * problem. Probing tentatively fixes u before v, propagates it through the
+ * transitivity of the order (using the interval-forced pairs and the pairs
+ * already fixed) and adds the extra cost of every pair it orients against
+ * its cheapest side. If that bound exceeds the upper bound (UB) given by a
+ * heuristic, no order with at most UB crossings has u before v, so v before u
+ * is fixed and LB grows accordingly.
+ *
+ * Pairs are probed in rounds on the thread pool. Inside a round every probe
+ * reads the state of the previous round; fixes are merged afterwards, which
+ * is sound because each of them holds for every order within UB.
+ */
+class OrientationProbing
+{
+public:
+  OrientationProbing(const graph::BipartiteGraph &graph,
+                     crossing::CrossingMatrix &cm);
+  ~OrientationProbing() = default;
+
+  /**
+   * Probes every orientable pair until a round fixes nothing new or
+   * 'time_limit' seconds have passed. Returns the fixed pairs (u, v),
+   * meaning that u precedes v.
+   */
+  std::vector<std::pair<int, int>> run(int upper_bound, double time_limit);
+
+  /** Combinatorial lower bound, considering the fixed pairs */
+  long long lowerBound() const;
+
+protected:
+  /** Orientation of a pair (i, j), i < j */
+  enum Orientation : signed char
+  {
+    BACKWARD = -1, // j before i
+    UNKNOWN = 0,
+    FORWARD = 1, // i before j
+  };
+
+  /** Extra cost of assuming 'u' before 'v', or -1 if it is infeasible */
+  long long probe(int u, int v, int upper_bound) const;
+  /** Whether 'u' before 'v' is known, either forced or fixed */
+  bool knownBefore(int u, int v) const;
+  /** Extra cost of orienting pair 'p' as 'o' */
+  long long extraCost(int p, Orientation o) const;
+
+  /** Orientable pairs (i, j), i < j, and their crossing numbers */
+  crossing::OrientablePairs m_pairs;
+  std::vector<std::pair<int, int>> m_costs;
+  std::vector<Orientation> m_state;
+  long long m_lowerBound;
+};
+
+} // namespace ip
+} // namespace solver
+} // namespace banana
+
+#endif // __PACE2024__ORIENTATION_PROBING_H
@@ -0,0 +1,151 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   Alan Prado
+ *
+ * This file is part of Banana, a one-sided crossing minimization solver.
+ *
+ * Copyright (c) 2024 by the authors listed in the file AUTHORS in the
+ * top-level source directory and their institutional affiliations. All rights
+ * reserved. See the file LICENSE.md in the top-level source directory for
+ * licensing information.
+ * ****************************************************************************
+ *
+ * Adaptive scheduling of a portfolio of heuristics.
+ */
+
+#include "portfolio.h"
+#include "environment.h"
+#include "thread_pool.h"
+
+#include <cmath>
+#include <ctime>
+#include <iostream>
+
+namespace banana {
+namespace solver {
+namespace heuristic {
+namespace portfolio {
+
+/** Shortest slice that counts, so that instant slices get finite rates */
+const double MIN_SECONDS = 1e-3;
+/** Initial time share of each routine per slice */
+const double SLICE_SECONDS = 2;
+
+Portfolio::Portfolio(graph::BipartiteGraph graph)
+    : MetaSolver<graph::BipartiteGraph, int>(graph)
+{}
+
+void Portfolio::addConstructive(std::unique_ptr<ApproximationRoutine> heuristic)
+{
+  m_constructive.push_back(std::move(heuristic));
+}
+
+void Portfolio::addImprovement(std::unique_ptr<ImprovementRoutine> heuristic)
+{
+  m_arms.push_back(Arm());
+  m_arms.back().routine = std::move(heuristic);
+  m_arms.back().seconds = SLICE_SECONDS;
+}
+
+int Portfolio::select() const
+{
+  int best = -1;
+  double best_score = 0;
+  for (int a = 0; a < (int)m_arms.size(); a++)
+  {
+    const Arm &arm = m_arms[a];
+    if (arm.stale == m_version)
+      continue;
+    if (arm.slices == 0)
+      return a;
+    double mean = m_bestRate > 0 ? arm.rate / arm.slices / m_bestRate : 0;
+    double score = mean + std::sqrt(2 * std::log(m_slices) / arm.slices);
+    if (best == -1 || score > best_score)
+      best = a, best_score = score;
+  }
+  return best;
+}
+
+long long Portfolio::solve()
+{
+  const utils::Deadline &deadline = Environment::deadline();
+
+  int count = m_constructive.size();
+  std::vector<std::vector<int>> orders(count);
+  std::vector<long long> crossings(count, -1);
+  library::ThreadPool::global().parallelFor(0, count, [&](int h) {
+    if (h > 0 && deadline.expired())
+      return;
+    crossings[h] = m_constructive[h]->solve();
+    m_constructive[h]->explain(orders[h]);
+    publish(orders[h], crossings[h]);
+  });
+
+  long long best = -1;
+  for (int h = 0; h < count; h++)
+  {
+    if (crossings[h] == -1)
+      continue;
+    std::cerr << "portfolio: constructive " << crossings[h] << std::endl;
+    if (best == -1 || crossings[h] < best)
+      best = crossings[h], m_order = std::move(orders[h]);
+  }
+  if (best == -1)
+  {
+    m_order = m_graph.getB();
+    best = numberOfCrossings(m_order);
+  }
+  publish(m_order, best);
+
+  for (Arm &arm : m_arms)
+  {
+    arm.routine->setIncumbent(m_incumbent);
+  }
+  int a;
+  while (!deadline.expired() && (a = select()) != -1)
+  {
+    Arm &arm = m_arms[a];
+    std::vector<int> order = m_order;
+    std::clock_t start = std::clock();
+    utils::Deadline slice_end(arm.seconds);
+    long long result;
+    {
+      Environment::TimeSlice slice(arm.seconds);
+      result = arm.routine->improve(order, best);
+    }
+    bool cut = slice_end.expired();
+    double seconds =
+        std::max(MIN_SECONDS, double(std::clock() - start) / CLOCKS_PER_SEC);
+
+    double rate = std::max(0ll, best - result) / seconds;
+    arm.slices++, m_slices++;
+    arm.rate += rate;
+    m_bestRate = std::max(m_bestRate, rate);
+    std::cerr << "portfolio: routine " << a << " slice " << arm.slices
+              << " gain " << std::max(0ll, best - result) << " in "
+              << seconds << " cpu s" << (cut ? " (cut)" : "")
+              << std::endl;
+    if (result < best)
+    {
+      best = result, m_order = std::move(order), m_version++;
+      publish(m_order, best);
+    }
+    else if (cut)
+    {
+      arm.seconds *= 2;
+    }
+    else
+    {
+      arm.stale = m_version;
+    }
+  }
+
+  std::cerr << "portfolio: " << best << " after " << m_slices << " slices"
+            << std::endl;
+  return best;
+}
+
+} // namespace portfolio
+} // namespace heuristic
+} // namespace solver
+} // namespace banana
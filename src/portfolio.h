@@ -0,0 +1,96 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   Alan Prado
+ *
+ * This file is part of Banana, a one-sided crossing minimization solver.
+ *
+ * Copyright (c) 2024 by the authors listed in the file AUTHORS in the
+ * top-level source directory and their institutional affiliations. All rights
+ * reserved. See the file LICENSE.md in the top-level source directory for
+ * licensing information.
+ * ****************************************************************************
+ *
+ * Adaptive scheduling of a portfolio of heuristics.
+ */
+
+#ifndef __PACE2024__PORTFOLIO_H
+#define __PACE2024__PORTFOLIO_H
+
+#include "approximation_routine.h"
+#include "improvement_routine.h"
+
+#include <memory>
+#include <vector>
+
+namespace banana {
+namespace solver {
+namespace heuristic {
+namespace portfolio {
+
+/**
+ * Heuristic portfolio
+ *
+ * Constructive heuristics are independent, so they all run at once on the
+ * thread pool, and the best order they find is the starting point. After
+ * that, the improvement routines compete for time slices, where a slice is
+ * one call to improve() on the best order, cut short by an
+ * Environment::TimeSlice. The reward of a slice is its gain per CPU second,
+ * relative to the best rate seen so far, and the next slice goes to the
+ * routine with the largest UCB1 score
+ *
+ *   mean reward + \sqrt{2 \ln(slices) / slices of the routine},
+ *
+ * so routines that pay off get most of the time, and the others are still
+ * tried now and then. A routine that finishes without improving is not
+ * called again until another one changes the order; one that is cut short
+ * without improving gets twice the time in its next slice, so that every
+ * routine eventually finishes a call. Every order found is published to
+ * the incumbent.
+ */
+class Portfolio : public MetaSolver<graph::BipartiteGraph, int>
+{
+public:
+  Portfolio(graph::BipartiteGraph graph);
+  ~Portfolio() override = default;
+
+  void addConstructive(std::unique_ptr<ApproximationRoutine> heuristic);
+  /** Routines are first tried in the order they are added */
+  void addImprovement(std::unique_ptr<ImprovementRoutine> heuristic);
+
+  /**
+   * Runs until no routine improves the best order or the deadline expires.
+   * The first constructive heuristic always runs. Returns the best crossings
+   * found.
+   */
+  long long solve() override;
+
+protected:
+  /** Index of the routine that gets the next slice, or -1 if none is left */
+  int select() const;
+
+  struct Arm
+  {
+    std::unique_ptr<ImprovementRoutine> routine;
+    int slices = 0;
+    /** Sum of the gains per CPU second of its slices */
+    double rate = 0;
+    /** Version of the best order on which it last improved nothing */
+    int stale = -1;
+    /** Wall-clock seconds of its next slice */
+    double seconds;
+  };
+
+  std::vector<std::unique_ptr<ApproximationRoutine>> m_constructive;
+  std::vector<Arm> m_arms;
+  /** Incremented every time the best order changes */
+  int m_version = 0;
+  int m_slices = 0;
+  double m_bestRate = 0;
+};
+
+} // namespace portfolio
+} // namespace heuristic
+} // namespace solver
+} // namespace banana
+
+#endif // __PACE2024__PORTFOLIO_H
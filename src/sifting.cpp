@@ -0,0 +1,128 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   Alan Prado
+ *
+ * This file is part of Banana, a one-sided crossing minimization solver.
+ *
+ * Copyright (c) 2024 by the authors listed in the file AUTHORS in the
+ * top-level source directory and their institutional affiliations. All rights
+ * reserved. See the file LICENSE.md in the top-level source directory for
+ * licensing information.
+ * ****************************************************************************
+ *
+ * Sifting local search.
+ */
+
+#include "sifting.h"
+#include "environment.h"
+
+#include <algorithm>
+
+namespace banana {
+namespace solver {
+namespace heuristic {
+namespace sifting {
+
+Sifting::Sifting(graph::BipartiteGraph graph) : ImprovementRoutine(graph)
+{
+  m_less.resize(graph.countVerticesA() + 1);
+  m_delta.resize(graph.countVerticesB());
+}
+
+long long Sifting::sift(std::vector<int> &order, std::vector<int> &position,
+                        int p)
+{
+  int n = order.size();
+  const auto &nv = m_neighbors[order[p] - m_offset];
+  long long dv = nv.size();
+  if (dv == 0)
+    return 0;
+
+  std::fill(m_less.begin(), m_less.end(), 0);
+  for (int a : nv)
+  {
+    m_less[a + 1]++;
+  }
+  for (int a = 1; a < (int)m_less.size(); a++)
+  {
+    m_less[a] += m_less[a - 1];
+  }
+
+  /**
+   * v before u crosses the edges of u ending strictly before a neighbor of v,
+   * and u before v those ending strictly after one.
+   */
+  for (int k = 0; k < n; k++)
+  {
+    long long vu = 0, uv = 0;
+    for (int b : m_neighbors[order[k] - m_offset])
+    {
+      uv += m_less[b];
+      vu += dv - m_less[b + 1];
+    }
+    m_delta[k] = vu - uv;
+  }
+
+  long long best = 0, sum = 0;
+  int target = p;
+  for (int k = p - 1; k >= 0; k--)
+  {
+    sum += m_delta[k];
+    if (sum < best)
+      best = sum, target = k;
+  }
+  sum = 0;
+  for (int k = p + 1; k < n; k++)
+  {
+    sum -= m_delta[k];
+    if (sum < best)
+      best = sum, target = k;
+  }
+
+  if (target < p)
+    std::rotate(order.begin() + target, order.begin() + p,
+                order.begin() + p + 1);
+  else if (target > p)
+    std::rotate(order.begin() + p, order.begin() + p + 1,
+                order.begin() + target + 1);
+  for (int k = std::min(p, target); k <= std::max(p, target); k++)
+  {
+    position[order[k] - m_offset] = k;
+  }
+  return best;
+}
+
+long long Sifting::improve(std::vector<int> &order, long long crossings)
+{
+  const utils::Deadline &deadline = Environment::deadline();
+  std::vector<int> position(order.size());
+  for (int k = 0; k < (int)order.size(); k++)
+  {
+    position[order[k] - m_offset] = k;
+  }
+
+  bool improved = true;
+  while (improved && !deadline.expired())
+  {
+    improved = false;
+    std::vector<int> vertices = order;
+    for (int v : vertices)
+    {
+      if (deadline.expired())
+        break;
+      long long change = sift(order, position, position[v - m_offset]);
+      if (change < 0)
+        crossings += change, improved = true;
+    }
+    if (improved)
+      publish(order, crossings);
+  }
+
+  m_order = order;
+  return crossings;
+}
+
+} // namespace sifting
+} // namespace heuristic
+} // namespace solver
+} // namespace banana
@@ -0,0 +1,65 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   Alan Prado
+ *
+ * This file is part of Banana, a one-sided crossing minimization solver.
+ *
+ * Copyright (c) 2024 by the authors listed in the file AUTHORS in the
+ * top-level source directory and their institutional affiliations. All rights
+ * reserved. See the file LICENSE.md in the top-level source directory for
+ * licensing information.
+ * ****************************************************************************
+ *
+ * Sifting local search.
+ */
+
+#ifndef __PACE2024__SIFTING_H
+#define __PACE2024__SIFTING_H
+
+#include "improvement_routine.h"
+
+#include <vector>
+
+namespace banana {
+namespace solver {
+namespace heuristic {
+namespace sifting {
+
+/**
+ * Sifting (Matuszewski, Schoenfeld and Molitor)
+ *
+ * Takes each vertex v in turn and moves it to the position that minimizes
+ * the crossings, keeping the relative order of the others. Moving v across
+ * a vertex u changes the crossings by c_{v,u} - c_{u,v}, so running sums of
+ * these differences from the current position of v give the cost of every
+ * position in O(n). The differences of v against all other vertices are
+ * computed at once in O(|A| + |E|), from the number of neighbors of v
+ * before each vertex of A. Sweeps repeat until no vertex moves.
+ */
+class Sifting : public ImprovementRoutine
+{
+public:
+  Sifting(graph::BipartiteGraph graph);
+  ~Sifting() override = default;
+  using ImprovementRoutine::improve;
+  long long improve(std::vector<int> &order, long long crossings) override;
+
+protected:
+  /**
+   * Moves order[p] to its best position. Returns the change in crossings,
+   * which is 0 if it stays.
+   */
+  long long sift(std::vector<int> &order, std::vector<int> &position, int p);
+
+  /** Neighbors of the sifted vertex before each vertex of A */
+  std::vector<int> m_less;
+  /** c_{v,u} - c_{u,v} for each vertex u, by position */
+  std::vector<long long> m_delta;
+};
+
+} // namespace sifting
+} // namespace heuristic
+} // namespace solver
+} // namespace banana
+
+#endif // __PACE2024__SIFTING_H
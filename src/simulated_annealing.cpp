@@ -0,0 +1,237 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   Alan Prado
+ *
+ * This file is part of Banana, a one-sided crossing minimization solver.
+ *
+ * Copyright (c) 2024 by the authors listed in the file AUTHORS in the
+ * top-level source directory and their institutional affiliations. All rights
+ * reserved. See the file LICENSE.md in the top-level source directory for
+ * licensing information.
+ * ****************************************************************************
+ *
+ * Simulated annealing over orders of B.
+ */
+
+#include "simulated_annealing.h"
+#include "barycenter_heuristic.h"
+#include "environment.h"
+#include "median_heuristic.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace banana {
+namespace solver {
+namespace heuristic {
+namespace annealing {
+
+const int MAX_DISTANCE = 32;
+const int MAX_BLOCK = 8;
+/** Moves sampled to set the initial temperature */
+const int SAMPLE_MOVES = 500;
+const double INITIAL_ACCEPTANCE = 0.05;
+/** Above this fraction of accepted uphill moves, it cools faster */
+const double HOT_ACCEPTANCE = 0.5;
+const double COOLING = 0.95;
+const double FAST_COOLING = 0.8;
+/** Below this fraction of accepted uphill moves, the run is frozen */
+const double FROZEN_ACCEPTANCE = 0.005;
+const int FROZEN_EPOCHS = 5;
+const int MIN_EPOCH = 10000;
+const int MAX_EPOCH = 100000;
+
+SimulatedAnnealing::SimulatedAnnealing(
+    graph::BipartiteGraph graph,
+    std::shared_ptr<const crossing::DenseCrossingMatrix> matrix)
+    : ImprovementRoutine(graph), m_matrix(matrix),
+      m_random(Environment::seed()), m_restarts(1), m_bestCrossings(0)
+{
+  if (m_matrix == nullptr && crossing::DenseCrossingMatrix::fits(graph))
+    m_matrix = std::make_shared<crossing::DenseCrossingMatrix>(graph);
+}
+
+void SimulatedAnnealing::setRestarts(int restarts) { m_restarts = restarts; }
+
+void SimulatedAnnealing::setSeed(unsigned long long seed)
+{
+  m_random.seed(seed);
+}
+
+SimulatedAnnealing::Move
+SimulatedAnnealing::propose(const std::vector<int> &order)
+{
+  int n = order.size();
+  const crossing::DenseCrossingMatrix *matrix = m_matrix.get();
+  auto uniform = [&](int bound) { return (int)(m_random() % bound); };
+  Move move;
+  move.type = static_cast<MoveType>(uniform(3));
+  move.length = 1;
+  move.delta = 0;
+  if (move.type == MoveType::BLOCK)
+  {
+    move.length = std::min(2 + uniform(MAX_BLOCK - 1), n - 1);
+  }
+  int distance = 1 + uniform(std::min(MAX_DISTANCE, n - move.length));
+
+  if (move.type == MoveType::SWAP)
+  {
+    move.from = uniform(n - distance);
+    move.to = move.from + distance;
+    int a = order[move.from], b = order[move.to];
+    for (int k = move.from + 1; k < move.to; k++)
+    {
+      move.delta += flip(a, order[k], matrix) + flip(order[k], b, matrix);
+    }
+    move.delta += flip(a, b, matrix);
+    return move;
+  }
+
+  /** Inserts are blocks of length 1 */
+  bool right = uniform(2) == 0;
+  move.from = uniform(n - move.length - distance + 1);
+  if (!right)
+    move.from += distance;
+  move.to = right ? move.from + distance : move.from - distance;
+  int begin = move.from, end = move.from + move.length;
+  if (right)
+  {
+    for (int k = end; k < end + distance; k++)
+    {
+      for (int b = begin; b < end; b++)
+      {
+        move.delta += flip(order[b], order[k], matrix);
+      }
+    }
+  }
+  else
+  {
+    for (int k = move.to; k < begin; k++)
+    {
+      for (int b = begin; b < end; b++)
+      {
+        move.delta += flip(order[k], order[b], matrix);
+      }
+    }
+  }
+  return move;
+}
+
+void SimulatedAnnealing::apply(std::vector<int> &order, const Move &move) const
+{
+  auto it = order.begin();
+  if (move.type == MoveType::SWAP)
+    std::swap(order[move.from], order[move.to]);
+  else if (move.to > move.from)
+    std::rotate(it + move.from, it + move.from + move.length,
+                it + move.to + move.length);
+  else
+    std::rotate(it + move.to, it + move.from, it + move.from + move.length);
+}
+
+void SimulatedAnnealing::anneal(std::vector<int> order, long long crossings)
+{
+  const utils::Deadline &deadline = Environment::deadline();
+  int n = order.size();
+  std::uniform_real_distribution<double> probability(0, 1);
+
+  double total = 0;
+  int count = 0;
+  for (int s = 0; s < SAMPLE_MOVES; s++)
+  {
+    Move move = propose(order);
+    if (move.delta > 0)
+      total += move.delta, count++;
+  }
+  double temperature =
+      std::max(1.0, count ? total / count : 0) / -std::log(INITIAL_ACCEPTANCE);
+  int epoch = std::clamp(20 * n, MIN_EPOCH, MAX_EPOCH);
+
+  /** The current order is copied only when an uphill move leaves a best */
+  bool at_best = crossings <= m_bestCrossings;
+  if (at_best)
+    m_bestCrossings = crossings;
+  for (int frozen = 0; frozen < FROZEN_EPOCHS && !deadline.expired();)
+  {
+    long long epoch_best = m_bestCrossings;
+    int uphill = 0, uphill_accepted = 0;
+    for (int it = 0; it < epoch; it++)
+    {
+      Move move = propose(order);
+      uphill += move.delta > 0;
+      if (move.delta > 0 &&
+          probability(m_random) >= std::exp(-move.delta / temperature))
+        continue;
+      if (move.delta > 0)
+      {
+        uphill_accepted++;
+        if (at_best)
+          m_best = order, at_best = false;
+      }
+      apply(order, move);
+      crossings += move.delta;
+      if (crossings < m_bestCrossings)
+        m_bestCrossings = crossings, at_best = true;
+    }
+
+    if (m_bestCrossings < epoch_best)
+      publish(at_best ? order : m_best, m_bestCrossings);
+    if (m_bestCrossings < epoch_best ||
+        uphill_accepted > FROZEN_ACCEPTANCE * uphill)
+      frozen = 0;
+    else
+      frozen++;
+    temperature *=
+        uphill_accepted > HOT_ACCEPTANCE * uphill ? FAST_COOLING : COOLING;
+  }
+  if (at_best)
+    m_best = order;
+}
+
+long long SimulatedAnnealing::improve(std::vector<int> &order,
+                                      long long crossings)
+{
+  m_best = order, m_bestCrossings = crossings;
+  if (order.size() >= 2)
+  {
+    anneal(order, crossings);
+    for (int r = 0; r < m_restarts; r++)
+    {
+      anneal(m_best, m_bestCrossings);
+    }
+  }
+  order = m_best;
+  m_order = m_best;
+  return m_bestCrossings;
+}
+
+long long SimulatedAnnealing::solve()
+{
+  std::vector<std::unique_ptr<ApproximationRoutine>> starts;
+  starts.push_back(
+      std::make_unique<barycenter::BarycenterHeuristic>(m_graph));
+  starts.push_back(std::make_unique<median::MedianHeuristic>(m_graph));
+
+  m_best.clear();
+  for (auto &h : starts)
+  {
+    long long crossings = h->solve();
+    std::vector<int> order;
+    h->explain(order);
+    if (m_best.empty() || crossings < m_bestCrossings)
+      m_best = order, m_bestCrossings = crossings;
+    if (order.size() >= 2)
+      anneal(order, crossings);
+  }
+  for (int r = 0; r < m_restarts && m_best.size() >= 2; r++)
+  {
+    anneal(m_best, m_bestCrossings);
+  }
+  m_order = m_best;
+  return m_bestCrossings;
+}
+
+} // namespace annealing
+} // namespace heuristic
+} // namespace solver
+} // namespace banana
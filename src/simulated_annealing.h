@@ -0,0 +1,101 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   Alan Prado
+ *
+ * This file is part of Banana, a one-sided crossing minimization solver.
+ *
+ * Copyright (c) 2024 by the authors listed in the file AUTHORS in the
+ * top-level source directory and their institutional affiliations. All rights
+ * reserved. See the file LICENSE.md in the top-level source directory for
+ * licensing information.
+ * ****************************************************************************
+ *
+ * Simulated annealing over orders of B.
+ */
+
+#ifndef __PACE2024__SIMULATED_ANNEALING_H
+#define __PACE2024__SIMULATED_ANNEALING_H
+
+#include "dense_crossing_matrix.h"
+#include "improvement_routine.h"
+
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace banana {
+namespace solver {
+namespace heuristic {
+namespace annealing {
+
+/**
+ * Simulated annealing
+ *
+ * Moves are taken within MAX_DISTANCE positions:
+ *
+ *   swap:   exchanges the vertices at positions i and j;
+ *   insert: moves the vertex at position i to position j;
+ *   block:  moves up to MAX_BLOCK consecutive vertices by a few positions.
+ *
+ * The delta of a move is the sum of c_{v,u} - c_{u,v} over the pairs it
+ * flips: O(1) lookups per pair with a DenseCrossingMatrix when it fits, and
+ * a merge of the two sorted neighborhoods otherwise.
+ *
+ * The initial temperature accepts an average uphill move with probability
+ * INITIAL_ACCEPTANCE. After each epoch the temperature is cooled, faster
+ * while most uphill moves are accepted, and a run ends after FROZEN_EPOCHS
+ * epochs in a row that found no new best order and accepted almost no
+ * uphill moves. Runs restart from the barycenter and median
+ * orders (solve) or from the given order (improve), and then from the best
+ * order found. Randomness comes from Environment::seed(), so runs without a
+ * time limit are reproducible.
+ */
+class SimulatedAnnealing : public ImprovementRoutine
+{
+public:
+  SimulatedAnnealing(
+      graph::BipartiteGraph graph,
+      std::shared_ptr<const crossing::DenseCrossingMatrix> matrix = nullptr);
+  ~SimulatedAnnealing() override = default;
+  long long solve() override;
+  using ImprovementRoutine::improve;
+  long long improve(std::vector<int> &order, long long crossings) override;
+
+  /** Runs after the ones from the starting orders; 0 disables them */
+  void setRestarts(int restarts);
+  void setSeed(unsigned long long seed);
+
+protected:
+  enum class MoveType
+  {
+    SWAP,
+    INSERT,
+    BLOCK
+  };
+  struct Move
+  {
+    MoveType type;
+    /** Positions: the block [from, from + length) goes to start at 'to' */
+    int from, to, length;
+    long long delta;
+  };
+
+  Move propose(const std::vector<int> &order);
+  void apply(std::vector<int> &order, const Move &move) const;
+  /** One annealing run from 'order'; keeps the best order in m_best */
+  void anneal(std::vector<int> order, long long crossings);
+
+  std::shared_ptr<const crossing::DenseCrossingMatrix> m_matrix;
+  std::mt19937_64 m_random;
+  int m_restarts;
+
+  std::vector<int> m_best;
+  long long m_bestCrossings;
+};
+
+} // namespace annealing
+} // namespace heuristic
+} // namespace solver
+} // namespace banana
+
+#endif // __PACE2024__SIMULATED_ANNEALING_H
@@ -0,0 +1,200 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   Alan Prado
+ *
+ * This file is part of Banana, a one-sided crossing minimization solver.
+ *
+ * Copyright (c) 2024 by the authors listed in the file AUTHORS in the
+ * top-level source directory and their institutional affiliations. All rights
+ * reserved. See the file LICENSE.md in the top-level source directory for
+ * licensing information.
+ * ****************************************************************************
+ *
+ * Spectral ordering of B.
+ */
+
+#include "spectral_ordering.h"
+#include "adjacent_exchange.h"
+#include "environment.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace banana {
+namespace solver {
+namespace heuristic {
+namespace spectral {
+
+const int MAX_ITERATIONS = 512;
+/** Power iteration stops once a step moves the unit vector less than this */
+const double TOLERANCE = 1e-7;
+const int SPMV_GRAIN = 1024;
+
+SpectralOrdering::SpectralOrdering(graph::BipartiteGraph graph)
+    : ApproximationRoutine(graph), m_nA(graph.countVerticesA()),
+      m_nB(graph.countVerticesB())
+{
+  std::vector<std::vector<int>> by_a(m_nA);
+  m_startB.push_back(0);
+  for (int v = 0; v < m_nB; v++)
+  {
+    std::vector<int> neighbors = graph.neighborhood(v + m_nA);
+    std::sort(neighbors.begin(), neighbors.end());
+    for (int a : neighbors)
+    {
+      m_columnB.push_back(a);
+      by_a[a].push_back(v);
+    }
+    m_startB.push_back(m_columnB.size());
+  }
+  m_startA.push_back(0);
+  for (const auto &neighbors : by_a)
+  {
+    m_columnA.insert(m_columnA.end(), neighbors.begin(), neighbors.end());
+    m_startA.push_back(m_columnA.size());
+  }
+}
+
+void SpectralOrdering::similarity(const std::vector<double> &x,
+                                  std::vector<double> &y) const
+{
+  library::ThreadPool &pool = library::ThreadPool::global();
+  std::vector<double> z(m_nA), smooth(m_nA);
+  pool.parallelFor(
+      0, m_nA,
+      [&](int a) {
+        double sum = 0;
+        for (int i = m_startA[a]; i < m_startA[a + 1]; i++)
+        {
+          sum += x[m_columnA[i]];
+        }
+        z[a] = sum;
+      },
+      SPMV_GRAIN);
+  pool.parallelFor(
+      0, m_nA,
+      [&](int a) {
+        smooth[a] = 2 * z[a] + (a > 0 ? z[a - 1] : 0) +
+                    (a + 1 < m_nA ? z[a + 1] : 0);
+      },
+      SPMV_GRAIN);
+  pool.parallelFor(
+      0, m_nB,
+      [&](int v) {
+        double sum = 0;
+        for (int i = m_startB[v]; i < m_startB[v + 1]; i++)
+        {
+          sum += smooth[m_columnB[i]];
+        }
+        y[v] = sum;
+      },
+      SPMV_GRAIN);
+}
+
+long long SpectralOrdering::solve()
+{
+  m_order.clear();
+  if (m_nB == 0)
+    return 0;
+  const utils::Deadline &deadline = Environment::deadline();
+  std::vector<double> degree(m_nB), x(m_nB), y(m_nB);
+  similarity(std::vector<double>(m_nB, 1), degree);
+  double sigma = 2 * *std::max_element(degree.begin(), degree.end()) + 1;
+
+  /** Centered, unit length, and orthogonal to the constant vector */
+  auto normalize = [&](std::vector<double> &v) {
+    double mean = 0, norm = 0;
+    for (double value : v)
+    {
+      mean += value;
+    }
+    mean /= m_nB;
+    for (double &value : v)
+    {
+      value -= mean;
+      norm += value * value;
+    }
+    norm = std::sqrt(norm);
+    for (double &value : v)
+    {
+      value = norm == 0 ? 0 : value / norm;
+    }
+  };
+
+  /** Barycenters as the starting vector */
+  for (int v = 0; v < m_nB; v++)
+  {
+    double sum = 0;
+    for (int i = m_startB[v]; i < m_startB[v + 1]; i++)
+    {
+      sum += m_columnB[i];
+    }
+    int d = m_startB[v + 1] - m_startB[v];
+    x[v] = d == 0 ? 0 : sum / d;
+  }
+  normalize(x);
+
+  /** Sorts B by 'x', keeping the sign with fewer crossings */
+  std::vector<int> order, best_order;
+  long long best = -1;
+  auto evaluate = [&]() {
+    order.resize(m_nB);
+    for (int v = 0; v < m_nB; v++)
+    {
+      order[v] = v + m_nA;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](int u, int v) {
+      return x[u - m_nA] < x[v - m_nA];
+    });
+    for (int sign = 0; sign < 2; sign++)
+    {
+      long long crossings = numberOfCrossings(order);
+      if (best == -1 || crossings < best)
+        best = crossings, best_order = order;
+      std::reverse(order.begin(), order.end());
+    }
+  };
+
+  /**
+   * The iterates move from the barycenters towards the Fiedler vector, and
+   * the ones in between are often better orders than either end, so every
+   * iterate at a power of two is evaluated as well as the last one
+   */
+  int iterations = 0;
+  while (iterations < MAX_ITERATIONS && !deadline.expired())
+  {
+    if ((iterations & (iterations - 1)) == 0)
+      evaluate();
+    /** y = (\sigma I - L) x = (\sigma - D) x + S x */
+    similarity(x, y);
+    for (int v = 0; v < m_nB; v++)
+    {
+      y[v] += (sigma - degree[v]) * x[v];
+    }
+    normalize(y);
+    double change = 0;
+    for (int v = 0; v < m_nB; v++)
+    {
+      change += (y[v] - x[v]) * (y[v] - x[v]);
+    }
+    x.swap(y);
+    iterations++;
+    if (change < TOLERANCE * TOLERANCE)
+      break;
+  }
+  evaluate();
+  std::cerr << "spectral: " << iterations << " iterations, crossings "
+            << best << std::endl;
+
+  exchange::AdjacentExchange exchange(m_graph);
+  long long crossings = exchange.improve(best_order, best);
+  m_order = best_order;
+  return crossings;
+}
+
+} // namespace spectral
+} // namespace heuristic
+} // namespace solver
+} // namespace banana
@@ -0,0 +1,68 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   Alan Prado
+ *
+ * This file is part of Banana, a one-sided crossing minimization solver.
+ *
+ * Copyright (c) 2024 by the authors listed in the file AUTHORS in the
+ * top-level source directory and their institutional affiliations. All rights
+ * reserved. See the file LICENSE.md in the top-level source directory for
+ * licensing information.
+ * ****************************************************************************
+ *
+ * Spectral ordering of B.
+ */
+
+#ifndef __PACE2024__SPECTRAL_ORDERING_H
+#define __PACE2024__SPECTRAL_ORDERING_H
+
+#include "approximation_routine.h"
+
+#include <vector>
+
+namespace banana {
+namespace solver {
+namespace heuristic {
+namespace spectral {
+
+/**
+ * Spectral ordering
+ *
+ * Sorts B by the Fiedler vector of the Laplacian L = D - S of a similarity
+ * graph on B. Two vertices are similar when they have neighbors at the same
+ * or at consecutive positions of A, that is, S = M K M^T, where M is the
+ * B x A adjacency matrix and K is tridiagonal with weights 2 on the diagonal
+ * and 1 next to it. S is never formed: each product S x goes through A, as
+ * M (K (M^T x)), on the CSR neighbor arrays of both sides and on the thread
+ * pool.
+ *
+ * The vector is found by power iteration on \sigma I - L, with \sigma above
+ * the largest eigenvalue and the constant vector projected out, starting
+ * from the barycenters. The iterates at powers of two and the last one are
+ * sorted in both directions, and the order with fewest crossings is refined
+ * with adjacent exchanges.
+ */
+class SpectralOrdering : public ApproximationRoutine
+{
+public:
+  SpectralOrdering(graph::BipartiteGraph graph);
+  ~SpectralOrdering() override = default;
+  long long solve() override;
+
+protected:
+  /** y = S x */
+  void similarity(const std::vector<double> &x, std::vector<double> &y) const;
+
+  int m_nA, m_nB;
+  /** Neighbors of each vertex of B, as indices of A, in CSR form */
+  std::vector<int> m_startB, m_columnB;
+  /** Neighbors of each vertex of A, as indices of B, in CSR form */
+  std::vector<int> m_startA, m_columnA;
+};
+
+} // namespace spectral
+} // namespace heuristic
+} // namespace solver
+} // namespace banana
+
+#endif // __PACE2024__SPECTRAL_ORDERING_H
@@ -0,0 +1,191 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   Alan Prado
+ *
+ * This file is part of Banana, a one-sided crossing minimization solver.
+ *
+ * Copyright (c) 2024 by the authors listed in the file AUTHORS in the
+ * top-level source directory and their institutional affiliations. All rights
+ * reserved. See the file LICENSE.md in the top-level source directory for
+ * licensing information.
+ * ****************************************************************************
+ *
+ * Tabu search over insertion moves.
+ */
+
+#include "tabu_search.h"
+#include "environment.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <climits>
+
+namespace banana {
+namespace solver {
+namespace heuristic {
+namespace tabu {
+
+/** Vertices whose insertions are evaluated in each iteration, and how far */
+const int CANDIDATES = 32;
+const int MAX_DISTANCE = 128;
+/** Iterations an orientation stays tabu: MIN_TENURE + [0, TENURE_RANGE) */
+const int MIN_TENURE = 7;
+const int TENURE_RANGE = 8;
+/** Iterations without a new best before a restart: clamp(n, MIN, MAX) */
+const int MIN_STALL = 1000;
+const int MAX_STALL = 5000;
+/** Perturbations applied to the best order on a restart */
+const int DIVERSIFICATION = 4;
+const int DEADLINE_CHECK = 64;
+
+TabuSearch::TabuSearch(
+    graph::BipartiteGraph graph,
+    std::shared_ptr<const crossing::DenseCrossingMatrix> matrix)
+    : ImprovementRoutine(graph), m_matrix(matrix),
+      m_random(Environment::seed()), m_restarts(4),
+      m_size(graph.countVerticesB()), m_iteration(0), m_bestCrossings(0)
+{
+  if (m_matrix == nullptr && crossing::DenseCrossingMatrix::fits(graph))
+    m_matrix = std::make_shared<crossing::DenseCrossingMatrix>(graph);
+}
+
+void TabuSearch::setRestarts(int restarts) { m_restarts = restarts; }
+
+void TabuSearch::setSeed(unsigned long long seed) { m_random.seed(seed); }
+
+TabuSearch::Move TabuSearch::bestMove(const std::vector<int> &order, int p,
+                                      long long aspiration) const
+{
+  const crossing::DenseCrossingMatrix &matrix = *m_matrix;
+  int n = order.size();
+  int v = order[p], bv = v - m_offset;
+  const int *row = matrix.row(bv);
+  Move best = {p, p, LLONG_MAX};
+
+  /** Once a tabu orientation is crossed, every farther position crosses it */
+  long long delta = 0;
+  bool crossed_tabu = false;
+  for (int k = p + 1; k < std::min(n, p + MAX_DISTANCE + 1); k++)
+  {
+    int u = order[k], bu = u - m_offset;
+    delta += (long long)matrix(bu, bv) - row[bu];
+    crossed_tabu = crossed_tabu || tabu(u, v);
+    if ((!crossed_tabu || delta < aspiration) && delta < best.delta)
+      best = {p, k, delta};
+  }
+  delta = 0, crossed_tabu = false;
+  for (int k = p - 1; k >= std::max(0, p - MAX_DISTANCE); k--)
+  {
+    int u = order[k], bu = u - m_offset;
+    delta += (long long)row[bu] - matrix(bu, bv);
+    crossed_tabu = crossed_tabu || tabu(v, u);
+    if ((!crossed_tabu || delta < aspiration) && delta < best.delta)
+      best = {p, k, delta};
+  }
+  return best;
+}
+
+void TabuSearch::apply(std::vector<int> &order, const Move &move)
+{
+  int v = order[move.from];
+  int expiry = m_iteration + MIN_TENURE + m_random() % TENURE_RANGE;
+  auto forbid = [&](int u, int w) {
+    m_tabu[(size_t)(u - m_offset) * m_size + (w - m_offset)] = expiry;
+  };
+  if (move.from < move.to)
+  {
+    for (int k = move.from + 1; k <= move.to; k++)
+    {
+      forbid(v, order[k]);
+    }
+    std::rotate(order.begin() + move.from, order.begin() + move.from + 1,
+                order.begin() + move.to + 1);
+  }
+  else
+  {
+    for (int k = move.to; k < move.from; k++)
+    {
+      forbid(order[k], v);
+    }
+    std::rotate(order.begin() + move.to, order.begin() + move.from,
+                order.begin() + move.from + 1);
+  }
+}
+
+void TabuSearch::search(std::vector<int> order, long long crossings)
+{
+  const utils::Deadline &deadline = Environment::deadline();
+  int n = order.size();
+  int stall_limit = std::clamp(n, MIN_STALL, MAX_STALL);
+  int candidates = std::min(n, CANDIDATES);
+  std::vector<int> sample(candidates);
+  std::vector<Move> moves(candidates);
+
+  for (int stall = 0; stall < stall_limit; stall++, m_iteration++)
+  {
+    if (m_iteration % DEADLINE_CHECK == 0 && deadline.expired())
+      break;
+
+    for (int &p : sample)
+    {
+      p = m_random() % n;
+    }
+    long long aspiration = m_bestCrossings - crossings;
+    library::ThreadPool::global().parallelFor(
+        0, candidates,
+        [&](int c) { moves[c] = bestMove(order, sample[c], aspiration); }, 8);
+
+    /** The first of the best moves, so that a seed gives a single run */
+    const Move *move = nullptr;
+    for (const Move &m : moves)
+    {
+      if (m.delta != LLONG_MAX && (move == nullptr || m.delta < move->delta))
+        move = &m;
+    }
+    if (move == nullptr)
+      continue;
+
+    apply(order, *move);
+    crossings += move->delta;
+    if (crossings < m_bestCrossings)
+    {
+      m_best = order, m_bestCrossings = crossings;
+      publish(m_best, m_bestCrossings);
+      stall = -1;
+    }
+  }
+}
+
+long long TabuSearch::improve(std::vector<int> &order, long long crossings)
+{
+  if (m_matrix == nullptr || order.size() < 2)
+    return crossings;
+
+  /** Orientations stay tabu across calls, but expire long before the next */
+  m_tabu.resize((size_t)m_size * m_size, INT_MIN);
+  m_iteration += MIN_TENURE + TENURE_RANGE;
+
+  m_best = order, m_bestCrossings = crossings;
+  search(order, crossings);
+  const utils::Deadline &deadline = Environment::deadline();
+  for (int r = 0; r < m_restarts && !deadline.expired(); r++)
+  {
+    std::vector<int> start = m_best;
+    long long start_crossings = m_bestCrossings;
+    for (int d = 0; d < DIVERSIFICATION; d++)
+    {
+      start_crossings += perturb(start, m_random, m_matrix.get());
+    }
+    m_iteration += MIN_TENURE + TENURE_RANGE;
+    search(start, start_crossings);
+  }
+
+  order = m_best;
+  m_order = m_best;
+  return m_bestCrossings;
+}
+
+} // namespace tabu
+} // namespace heuristic
+} // namespace solver
+} // namespace banana
@@ -0,0 +1,105 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   Alan Prado
+ *
+ * This file is part of Banana, a one-sided crossing minimization solver.
+ *
+ * Copyright (c) 2024 by the authors listed in the file AUTHORS in the
+ * top-level source directory and their institutional affiliations. All rights
+ * reserved. See the file LICENSE.md in the top-level source directory for
+ * licensing information.
+ * ****************************************************************************
+ *
+ * Tabu search over insertion moves.
+ */
+
+#ifndef __PACE2024__TABU_SEARCH_H
+#define __PACE2024__TABU_SEARCH_H
+
+#include "dense_crossing_matrix.h"
+#include "improvement_routine.h"
+
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace banana {
+namespace solver {
+namespace heuristic {
+namespace tabu {
+
+/**
+ * Tabu search
+ *
+ * Each iteration samples CANDIDATES vertices and, for each one, computes the
+ * cost of every insertion position within MAX_DISTANCE with running sums of
+ * c_{v,u} - c_{u,v} along the order, read from the dense crossing matrix.
+ * Candidates are evaluated on the thread pool. The best admissible
+ * move is made even if it is uphill, which is what gets the search across
+ * the plateaus of zero-delta moves that stop sifting.
+ *
+ * The tabu memory is keyed by pair orientations: when a move puts u after v,
+ * the orientation "u before v" is tabu for a few iterations, so neither
+ * vertex can undo it. A move that restores a tabu orientation is admissible
+ * only if it reaches a new best order (aspiration). After STALL iterations
+ * without a new best, the search restarts from a perturbation of the best
+ * order. Without a dense matrix, improve does nothing.
+ */
+class TabuSearch : public ImprovementRoutine
+{
+public:
+  TabuSearch(
+      graph::BipartiteGraph graph,
+      std::shared_ptr<const crossing::DenseCrossingMatrix> matrix = nullptr);
+  ~TabuSearch() override = default;
+  using ImprovementRoutine::improve;
+  long long improve(std::vector<int> &order, long long crossings) override;
+
+  /** Diversification restarts after the first search; 0 disables them */
+  void setRestarts(int restarts);
+  void setSeed(unsigned long long seed);
+
+protected:
+  /** Moves the vertex at position 'from' to position 'to' */
+  struct Move
+  {
+    int from, to;
+    long long delta;
+  };
+
+  /**
+   * Best admissible insertion of order[p]. 'aspiration' is the delta below
+   * which tabu moves are admissible.
+   */
+  Move bestMove(const std::vector<int> &order, int p,
+                long long aspiration) const;
+  /** Applies 'move' and makes the orientations it flipped tabu */
+  void apply(std::vector<int> &order, const Move &move);
+  /** Searches from 'order' until it stalls; keeps the best in m_best */
+  void search(std::vector<int> order, long long crossings);
+
+  bool tabu(int u, int v) const
+  {
+    return m_tabu[(size_t)(u - m_offset) * m_size + (v - m_offset)] >
+           m_iteration;
+  }
+
+  std::shared_ptr<const crossing::DenseCrossingMatrix> m_matrix;
+  std::mt19937_64 m_random;
+  int m_restarts;
+  int m_size;
+
+  /** Iteration until which each orientation (u before v) is tabu */
+  std::vector<int> m_tabu;
+  int m_iteration;
+
+  std::vector<int> m_best;
+  long long m_bestCrossings;
+};
+
+} // namespace tabu
+} // namespace heuristic
+} // namespace solver
+} // namespace banana
+
+#endif // __PACE2024__TABU_SEARCH_H
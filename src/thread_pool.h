@@ -0,0 +1,201 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   Alan Prado
+ *
+ * This file is part of Banana, a one-sided crossing minimization solver.
+ *
+ * Copyright (c) 2024 by the authors listed in the file AUTHORS in the
+ * top-level source directory and their institutional affiliations. All rights
+ * reserved. See the file LICENSE.md in the top-level source directory for
+ * licensing information.
+ * ****************************************************************************
+ *
+ * Basic Thread Pool Implementation
+ */
+
+#ifndef __PACE2024__THREAD_POOL_HPP
+#define __PACE2024__THREAD_POOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace banana {
+namespace library {
+
+/**
+ * Fixed-size pool of worker threads.
+ *
+ * Tasks given to `submit` are executed in FIFO order. Waiting on the future
+ * of a task from inside another task may deadlock, so tasks that need nested
+ * parallelism should use `parallelFor` instead: the calling thread takes part
+ * in the loop, and it only waits for chunks that are already running.
+ */
+class ThreadPool
+{
+public:
+  /** Creates a pool with 'threads' workers (none means run inline) */
+  ThreadPool(unsigned threads);
+  ~ThreadPool();
+
+  /** Process-wide pool, with one thread per hardware thread */
+  static ThreadPool &global();
+
+  /** Number of threads able to run work, counting the caller */
+  unsigned size() const;
+
+  /** Enqueues 'task'. The future is ready as soon as the task returns. */
+  std::future<void> submit(std::function<void()> task);
+
+  /**
+   * Calls 'body(i)' for every i in [begin, end), in chunks of 'grain'
+   * consecutive indexes. Returns after every call has finished.
+   */
+  template <class F>
+  void parallelFor(int begin, int end, const F &body, int grain = 1);
+
+protected:
+  void workerLoop();
+
+  std::vector<std::thread> m_workers;
+  std::queue<std::packaged_task<void()>> m_tasks;
+  std::mutex m_mutex;
+  std::condition_variable m_condition;
+  bool m_stop = false;
+};
+
+inline ThreadPool::ThreadPool(unsigned threads)
+{
+  for (unsigned i = 0; i < threads; i++)
+  {
+    m_workers.emplace_back([this]() { workerLoop(); });
+  }
+}
+
+inline ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_condition.notify_all();
+  for (std::thread &worker : m_workers)
+  {
+    worker.join();
+  }
+}
+
+inline ThreadPool &ThreadPool::global()
+{
+  /** The caller also runs work, so one thread less is enough */
+  static ThreadPool pool(
+      std::max(1u, std::thread::hardware_concurrency()) - 1);
+  return pool;
+}
+
+inline unsigned ThreadPool::size() const
+{
+  return (unsigned)m_workers.size() + 1;
+}
+
+inline std::future<void> ThreadPool::submit(std::function<void()> task)
+{
+  std::packaged_task<void()> packaged(std::move(task));
+  std::future<void> future = packaged.get_future();
+  if (m_workers.empty())
+  {
+    packaged();
+    return future;
+  }
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_tasks.push(std::move(packaged));
+  }
+  m_condition.notify_one();
+  return future;
+}
+
+inline void ThreadPool::workerLoop()
+{
+  while (true)
+  {
+    std::packaged_task<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_condition.wait(lock, [this]() { return m_stop || !m_tasks.empty(); });
+      if (m_stop && m_tasks.empty())
+        return;
+      task = std::move(m_tasks.front());
+      m_tasks.pop();
+    }
+    task();
+  }
+}
+
+template <class F>
+void ThreadPool::parallelFor(int begin, int end, const F &body, int grain)
+{
+  if (end <= begin)
+    return;
+  grain = std::max(grain, 1);
+  int chunks = (end - begin + grain - 1) / grain;
+
+  if (chunks == 1 || m_workers.empty())
+  {
+    for (int i = begin; i < end; i++)
+      body(i);
+    return;
+  }
+
+  /**
+   * Helpers may be dequeued after the loop is over, so the shared state
+   * outlives this call. A helper only touches 'body' when it claims a chunk,
+   * and that can only happen while the caller is still waiting.
+   */
+  struct State
+  {
+    std::atomic<int> next{0};
+    std::atomic<int> finished{0};
+    std::mutex mutex;
+    std::condition_variable done;
+  };
+  auto state = std::make_shared<State>();
+
+  auto run_chunks = [state, chunks, begin, end, grain, &body]() {
+    int chunk;
+    while ((chunk = state->next.fetch_add(1)) < chunks)
+    {
+      int from = begin + chunk * grain;
+      int to = std::min(end, from + grain);
+      for (int i = from; i < to; i++)
+        body(i);
+      if (state->finished.fetch_add(1) + 1 == chunks)
+      {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        state->done.notify_all();
+      }
+    }
+  };
+
+  int helpers = std::min<int>(chunks - 1, m_workers.size());
+  for (int i = 0; i < helpers; i++)
+  {
+    submit(run_chunks);
+  }
+  run_chunks();
+
+  std::unique_lock<std::mutex> lock(state->mutex);
+  state->done.wait(lock, [&]() { return state->finished.load() == chunks; });
+}
+
+} // namespace library
+} // namespace banana
+
+#endif // __PACE2024__THREAD_POOL_HPP
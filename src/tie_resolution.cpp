@@ -0,0 +1,169 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   Alan Prado
+ *
+ * This file is part of Banana, a one-sided crossing minimization solver.
+ *
+ * Copyright (c) 2024 by the authors listed in the file AUTHORS in the
+ * top-level source directory and their institutional affiliations. All rights
+ * reserved. See the file LICENSE.md in the top-level source directory for
+ * licensing information.
+ * ****************************************************************************
+ *
+ * Ordering of groups of vertices with equal keys.
+ */
+
+#include "tie_resolution.h"
+#include "crossing_matrix.h"
+#include "environment.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+
+namespace banana {
+namespace solver {
+namespace heuristic {
+namespace ties {
+
+/** Sifting a group costs O(size^2) crossing numbers per sweep */
+const int MAX_GROUP = 4096;
+const int MAX_SWEEPS = 8;
+
+TieResolution::TieResolution(const graph::BipartiteGraph &graph)
+    : m_exact(graph)
+{
+}
+
+void TieResolution::sift(std::vector<int> &group,
+                         std::vector<long long> &weight) const
+{
+  const utils::Deadline &deadline = Environment::deadline();
+  int size = group.size();
+  std::vector<long long> delta(size);
+  bool improved = true;
+  for (int sweep = 0; improved && sweep < MAX_SWEEPS && !deadline.expired();
+       sweep++)
+  {
+    improved = false;
+    std::vector<int> snapshot = group;
+    for (int v : snapshot)
+    {
+      int p = std::find(group.begin(), group.end(), v) - group.begin();
+      /** Moving v across u changes the crossings by c_{v,u} - c_{u,v} */
+      for (int k = 0; k < size; k++)
+      {
+        if (k == p)
+          continue;
+        auto [uv, vu] = crossing::CrossingMatrix::pairCrossings(
+            m_exact.neighborhood(group[k]), m_exact.neighborhood(v));
+        delta[k] = (vu - uv) * weight[k] * weight[p];
+      }
+      long long best = 0, sum = 0;
+      int target = p;
+      for (int k = p - 1; k >= 0; k--)
+      {
+        sum += delta[k];
+        if (sum < best)
+          best = sum, target = k;
+      }
+      sum = 0;
+      for (int k = p + 1; k < size; k++)
+      {
+        sum -= delta[k];
+        if (sum < best)
+          best = sum, target = k;
+      }
+      if (target < p)
+      {
+        std::rotate(group.begin() + target, group.begin() + p,
+                    group.begin() + p + 1);
+        std::rotate(weight.begin() + target, weight.begin() + p,
+                    weight.begin() + p + 1);
+      }
+      else if (target > p)
+      {
+        std::rotate(group.begin() + p, group.begin() + p + 1,
+                    group.begin() + target + 1);
+        std::rotate(weight.begin() + p, weight.begin() + p + 1,
+                    weight.begin() + target + 1);
+      }
+      improved = improved || target != p;
+    }
+  }
+}
+
+void TieResolution::resolve(std::vector<int> &order,
+                            const std::vector<long long> &key)
+{
+  std::vector<std::pair<int, int>> groups;
+  for (int begin = 0, end = 0; begin < (int)order.size(); begin = end)
+  {
+    while (end < (int)order.size() && key[end] == key[begin])
+      end++;
+    if (end - begin >= 2)
+      groups.push_back({begin, end});
+  }
+
+  library::ThreadPool::global().parallelFor(0, groups.size(), [&](int g) {
+    auto [begin, end] = groups[g];
+    auto neighbors = [&](int v) -> const std::vector<int> & {
+      return m_exact.neighborhood(v);
+    };
+    /** Sorted apart, so that skipped groups keep their order */
+    std::vector<int> members(order.begin() + begin, order.begin() + end);
+    std::sort(members.begin(), members.end(),
+              [&](int u, int v) { return neighbors(u) < neighbors(v); });
+
+    /** One representative per class of twins */
+    std::vector<int> group;
+    std::vector<long long> weight;
+    for (int k = 0; k < (int)members.size(); k++)
+    {
+      if (k > 0 && neighbors(members[k]) == neighbors(members[k - 1]))
+      {
+        weight.back()++;
+        continue;
+      }
+      group.push_back(members[k]);
+      weight.push_back(1);
+    }
+
+    if ((int)group.size() == end - begin &&
+        end - begin <= windowdp::WindowDP::maxWindow())
+    {
+      m_exact.optimize(order, begin, end);
+      return;
+    }
+    if (group.size() < 2 || (int)group.size() > MAX_GROUP)
+      return;
+    std::vector<int> first(group.size());
+    for (int c = 1; c < (int)group.size(); c++)
+    {
+      first[c] = first[c - 1] + weight[c - 1];
+    }
+    std::vector<std::pair<int, int>> classes(group.size());
+    for (int c = 0; c < (int)group.size(); c++)
+    {
+      classes[c] = {group[c], first[c]};
+    }
+
+    sift(group, weight);
+    std::sort(classes.begin(), classes.end());
+    int k = begin;
+    for (int c = 0; c < (int)group.size(); c++)
+    {
+      int start = std::lower_bound(classes.begin(), classes.end(),
+                                   std::make_pair(group[c], -1))
+                      ->second;
+      for (int i = 0; i < weight[c]; i++)
+      {
+        order[k++] = members[start + i];
+      }
+    }
+  });
+}
+
+} // namespace ties
+} // namespace heuristic
+} // namespace solver
+} // namespace banana
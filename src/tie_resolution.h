@@ -0,0 +1,73 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   Alan Prado
+ *
+ * This file is part of Banana, a one-sided crossing minimization solver.
+ *
+ * Copyright (c) 2024 by the authors listed in the file AUTHORS in the
+ * top-level source directory and their institutional affiliations. All rights
+ * reserved. See the file LICENSE.md in the top-level source directory for
+ * licensing information.
+ * ****************************************************************************
+ *
+ * Ordering of groups of vertices with equal keys.
+ */
+
+#ifndef __PACE2024__TIE_RESOLUTION_H
+#define __PACE2024__TIE_RESOLUTION_H
+
+#include "bipartite_graph.h"
+#include "window_dp.h"
+
+#include <vector>
+
+namespace banana {
+namespace solver {
+namespace heuristic {
+namespace ties {
+
+/**
+ * Tie resolution
+ *
+ * Heuristics that sort B by a key, such as the barycenter or the median,
+ * leave vertices with equal keys in an arbitrary order. Vertices outside a
+ * group of ties keep their side of it, so only the crossings among the
+ * group change, and each group is ordered on its own.
+ *
+ * Twins, i.e. vertices with the same neighborhood, cross each other as
+ * often in either order and cross every other vertex alike, so their
+ * relative order does not matter and they can be kept together. Every
+ * group is first collapsed into classes of twins; sparse instances often
+ * have huge groups of leaves of the same hub. Groups without twins are
+ * ordered exactly with WindowDP::optimize() if they are small, and the
+ * others with sifting over the classes, where the crossings between two
+ * classes are weighted by their sizes. Groups of a single class or with
+ * more than MAX_GROUP classes are left as they are. Groups are solved in
+ * parallel on the thread pool.
+ */
+class TieResolution
+{
+public:
+  TieResolution(const graph::BipartiteGraph &graph);
+  ~TieResolution() = default;
+
+  /**
+   * Reorders each maximal run of positions with equal 'key' in 'order'.
+   * key[k] is the key of the vertex at position k.
+   */
+  void resolve(std::vector<int> &order, const std::vector<long long> &key);
+
+protected:
+  /** Sifting of the classes of twins 'group', of sizes 'weight' */
+  void sift(std::vector<int> &group, std::vector<long long> &weight) const;
+
+  /** Exact solver of small groups, and the sorted neighborhoods */
+  windowdp::WindowDP m_exact;
+};
+
+} // namespace ties
+} // namespace heuristic
+} // namespace solver
+} // namespace banana
+
+#endif // __PACE2024__TIE_RESOLUTION_H
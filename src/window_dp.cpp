@@ -0,0 +1,148 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   Alan Prado
+ *
+ * This file is part of Banana, a one-sided crossing minimization solver.
+ *
+ * Copyright (c) 2024 by the authors listed in the file AUTHORS in the
+ * top-level source directory and their institutional affiliations. All rights
+ * reserved. See the file LICENSE.md in the top-level source directory for
+ * licensing information.
+ * ****************************************************************************
+ *
+ * Exact reordering of small windows by dynamic programming.
+ */
+
+#include "window_dp.h"
+#include "crossing_matrix.h"
+
+#include <algorithm>
+
+namespace banana {
+namespace solver {
+namespace heuristic {
+namespace windowdp {
+
+const int WINDOW = 12;
+const int HALF = WINDOW / 2;
+
+WindowDP::WindowDP(graph::BipartiteGraph graph,
+                   std::shared_ptr<const crossing::DenseCrossingMatrix> matrix)
+    : ImprovementRoutine(graph), m_matrix(matrix)
+{}
+
+int WindowDP::maxWindow() { return WINDOW; }
+
+long long WindowDP::optimize(std::vector<int> &order, int begin,
+                             int end) const
+{
+  int w = end - begin;
+  if (w < 2)
+    return 0;
+
+  /** c[u][v]: crossings between u and v when u is first */
+  long long c[WINDOW][WINDOW] = {};
+  for (int i = 0; i < w; i++)
+  {
+    for (int j = i + 1; j < w; j++)
+    {
+      int u = order[begin + i] - m_offset, v = order[begin + j] - m_offset;
+      if (m_matrix != nullptr)
+      {
+        c[i][j] = (*m_matrix)(u, v), c[j][i] = (*m_matrix)(v, u);
+      }
+      else
+      {
+        auto [uv, vu] = crossing::CrossingMatrix::pairCrossings(
+            m_neighbors[u], m_neighbors[v]);
+        c[i][j] = uv, c[j][i] = vu;
+      }
+    }
+  }
+  long long current = 0;
+  for (int i = 0; i < w; i++)
+  {
+    for (int j = i + 1; j < w; j++)
+    {
+      current += c[i][j];
+    }
+  }
+
+  /** \sum_{u \in S} c_{u,v} = low[v][S & mask] + high[v][S >> HALF] */
+  int low_size = 1 << std::min(w, HALF);
+  int high_size = 1 << std::max(w - HALF, 0);
+  int mask = low_size - 1;
+  std::vector<long long> low(w * low_size), high(w * high_size);
+  for (int v = 0; v < w; v++)
+  {
+    for (int s = 1; s < low_size; s++)
+    {
+      int u = __builtin_ctz(s);
+      low[v * low_size + s] = low[v * low_size + (s & (s - 1))] + c[u][v];
+    }
+    for (int s = 1; s < high_size; s++)
+    {
+      int u = HALF + __builtin_ctz(s);
+      high[v * high_size + s] = high[v * high_size + (s & (s - 1))] + c[u][v];
+    }
+  }
+
+  int full = (1 << w) - 1;
+  std::vector<long long> best(full + 1);
+  std::vector<char> last(full + 1);
+  for (int s = 1; s <= full; s++)
+  {
+    best[s] = -1;
+    for (int rest = s; rest != 0; rest &= rest - 1)
+    {
+      int v = __builtin_ctz(rest);
+      int t = s ^ (1 << v);
+      long long cost = best[t] + low[v * low_size + (t & mask)] +
+                       high[v * high_size + (t >> HALF)];
+      if (best[s] == -1 || cost < best[s])
+        best[s] = cost, last[s] = v;
+    }
+  }
+  if (best[full] >= current)
+    return 0;
+
+  std::vector<int> window(order.begin() + begin, order.begin() + end);
+  for (int s = full, k = end - 1; s != 0; s ^= 1 << last[s], k--)
+  {
+    order[k] = window[last[s]];
+  }
+  return best[full] - current;
+}
+
+long long WindowDP::improve(std::vector<int> &order, long long crossings)
+{
+  int n = order.size();
+  /** Positions changed since the last phase of each kind solved them */
+  std::vector<char> dirty[2] = {std::vector<char>(n, 1),
+                                std::vector<char>(n, 1)};
+  crossings += improveBlocks(
+      n, WINDOW,
+      [&](int phase, int begin, int end) {
+        if (std::find(dirty[phase].begin() + begin,
+                      dirty[phase].begin() + end,
+                      1) == dirty[phase].begin() + end)
+          return 0ll;
+        long long delta = optimize(order, begin, end);
+        std::fill(dirty[phase].begin() + begin, dirty[phase].begin() + end,
+                  0);
+        if (delta < 0)
+          std::fill(dirty[phase ^ 1].begin() + begin,
+                    dirty[phase ^ 1].begin() + end, 1);
+        return delta;
+      },
+      16);
+
+  m_order = order;
+  publish(m_order, crossings);
+  return crossings;
+}
+
+} // namespace windowdp
+} // namespace heuristic
+} // namespace solver
+} // namespace banana
@@ -0,0 +1,75 @@
+/******************************************************************************
+ * Top contributors (to current version):
+ *   Alan Prado
+ *
+ * This file is part of Banana, a one-sided crossing minimization solver.
+ *
+ * Copyright (c) 2024 by the authors listed in the file AUTHORS in the
+ * top-level source directory and their institutional affiliations. All rights
+ * reserved. See the file LICENSE.md in the top-level source directory for
+ * licensing information.
+ * ****************************************************************************
+ *
+ * Exact reordering of small windows by dynamic programming.
+ */
+
+#ifndef __PACE2024__WINDOW_DP_H
+#define __PACE2024__WINDOW_DP_H
+
+#include "dense_crossing_matrix.h"
+#include "improvement_routine.h"
+
+#include <memory>
+#include <vector>
+
+namespace banana {
+namespace solver {
+namespace heuristic {
+namespace windowdp {
+
+/**
+ * Window dynamic programming
+ *
+ * Gives each window of WINDOW consecutive vertices its optimal internal
+ * order. Vertices outside a window keep their side of it, so only the
+ * crossings among its own vertices change, and the best order comes from
+ * the subset recurrence
+ *
+ *   f(S) = \min_{v \in S} f(S \ {v}) + \sum_{u \in S \ {v}} c_{u,v},
+ *
+ * in O(2^w w) time, with the inner sums read from two tables over the low
+ * and the high halves of S. Windows are solved as the blocks of
+ * ImprovementRoutine::improveBlocks, skipping those unchanged since their
+ * last phase.
+ *
+ * Crossing numbers come from 'matrix' when there is one, and from the
+ * sorted neighborhoods otherwise, so it refines any order, e.g. the ones of
+ * BarycenterHeuristic or MedianHeuristic.
+ */
+class WindowDP : public ImprovementRoutine
+{
+public:
+  WindowDP(
+      graph::BipartiteGraph graph,
+      std::shared_ptr<const crossing::DenseCrossingMatrix> matrix = nullptr);
+  ~WindowDP() override = default;
+  using ImprovementRoutine::improve;
+  long long improve(std::vector<int> &order, long long crossings) override;
+
+  /**
+   * Reorders order[begin, end) optimally, for end - begin at most
+   * maxWindow(). Returns the change in crossings. Thread-safe.
+   */
+  long long optimize(std::vector<int> &order, int begin, int end) const;
+  static int maxWindow();
+
+protected:
+  std::shared_ptr<const crossing::DenseCrossingMatrix> m_matrix;
+};
+
+} // namespace windowdp
+} // namespace heuristic
+} // namespace solver
+} // namespace banana
+
+#endif // __PACE2024__WINDOW_DP_H